@@ -0,0 +1,71 @@
+#pragma once
+
+#include "acl_unity_defines.h"
+
+extern "C"
+{
+	/// <summary>
+	/// Writes many compressed clips into a single archive file which can later be memory mapped with openClipArchive
+	/// </summary>
+	/// <param name="path">The path of the archive file to create or overwrite</param>
+	/// <param name="nameHashes">An array of numClips unique hashes identifying each clip</param>
+	/// <param name="compressedClips">An array of numClips pointers to compressed tracks buffers or combined clip blobs</param>
+	/// <param name="numClips">The number of clips to write</param>
+	/// <returns>1 if the archive was written, or 0 if a hash is duplicated, a clip is not recognized, or the file could not be written</returns>
+	/// <remarks>
+	/// Each clip may be either a buffer returned by the regular compression functions or a blob starting with a CompressedClipHeader.
+	/// Every clip is stored at a 16 byte aligned offset so that it can be sampled in place.
+	/// </remarks>
+	ACL_UNITY_API int buildClipArchive(const char* path, const unsigned long long* nameHashes, const void* const* compressedClips, int numClips);
+
+	/// <summary>
+	/// Memory maps an archive written by buildClipArchive for read-only access
+	/// </summary>
+	/// <param name="path">The path of the archive file</param>
+	/// <returns>A handle to the archive, or nullptr if the file could not be mapped or is not a valid archive. Release it with closeClipArchive.</returns>
+	/// <remarks>
+	/// The file is mapped rather than read, and pages are shared with every other process mapping the same file.
+	/// Opening checks the entry table and the headers of every clip, so it touches the first page of each clip.
+	/// The rest of each clip loads from disk the first time it is sampled. Its compressed data is not hashed.
+	/// </remarks>
+	ACL_UNITY_API void* openClipArchive(const char* path);
+
+	/// <summary>
+	/// Returns the number of clips in an archive
+	/// </summary>
+	/// <param name="archive">The handle returned by openClipArchive</param>
+	ACL_UNITY_API int getClipArchiveCount(const void* archive);
+
+	/// <summary>
+	/// Finds the index of a clip in an archive by its name hash
+	/// </summary>
+	/// <param name="archive">The handle returned by openClipArchive</param>
+	/// <param name="nameHash">The hash the clip was written with</param>
+	/// <returns>The index of the clip, or -1 if the archive does not contain it</returns>
+	ACL_UNITY_API int findClipInArchive(const void* archive, unsigned long long nameHash);
+
+	/// <summary>
+	/// Retrieves a clip stored in an archive without copying it
+	/// </summary>
+	/// <param name="archive">The handle returned by openClipArchive</param>
+	/// <param name="clipIndex">The index of the clip, between 0 and getClipArchiveCount() - 1</param>
+	/// <param name="outNameHash">Receives the hash the clip was written with. May be nullptr.</param>
+	/// <param name="outDurationInSeconds">Receives the duration of the clip. May be nullptr.</param>
+	/// <param name="outNumTracks">Receives the number of tracks, which is the number of bones for skeleton clips. May be nullptr.</param>
+	/// <param name="outSizeInBytes">Receives the size of the clip in bytes. May be nullptr.</param>
+	/// <param name="outIsCompressedClip">Receives 1 if the clip is a blob starting with a CompressedClipHeader, or 0 if it is a compressed tracks buffer. May be nullptr.</param>
+	/// <returns>A 16 byte aligned read-only pointer to the clip which remains valid until the archive is closed, or nullptr if clipIndex is out of range</returns>
+	ACL_UNITY_API const void* getClipFromArchive(const void*         archive,
+												 int                 clipIndex,
+												 unsigned long long* outNameHash,
+												 float*              outDurationInSeconds,
+												 int*                outNumTracks,
+												 int*                outSizeInBytes,
+												 int*                outIsCompressedClip);
+
+	/// <summary>
+	/// Unmaps an archive. All clip pointers retrieved from it become invalid.
+	/// </summary>
+	/// <param name="archive">The handle returned by openClipArchive</param>
+	ACL_UNITY_API void closeClipArchive(void* archive);
+}
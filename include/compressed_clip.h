@@ -0,0 +1,38 @@
+#pragma once
+
+#include "acl_unity_defines.h"
+
+/// <summary>
+/// The value of CompressedClipHeader.layoutTag for the layout described by CompressedClipHeader: 'ACC' followed by the layout version.
+/// Samplers and archives reject blobs with any other tag.
+/// </summary>
+#define ACL_UNITY_COMPRESSED_CLIP_LAYOUT_TAG 0x02434341
+
+extern "C"
+{
+	/// <summary>
+	/// The header at the start of a combined compressed clip blob. Each part is a regular compressed tracks buffer stored
+	/// within the blob at a 16-byte aligned offset from the start of the header, so the blob itself must be 16-byte aligned.
+	/// </summary>
+	struct CompressedClipHeader
+	{
+		/// <summary>The size of the whole blob in bytes, including this header</summary>
+		int totalSizeInBytes;
+		/// <summary>The offset in bytes of the compressed transform tracks</summary>
+		int transformTracksOffset;
+		/// <summary>The offset in bytes of the compressed uniform scale tracks, or 0 if all uniform scales are 1</summary>
+		int scaleTracksOffset;
+		/// <summary>The offset in bytes of the compressed scalar curve tracks, or 0 if the clip has no curves</summary>
+		int scalarTracksOffset;
+		/// <summary>The offset in bytes of the single pose of a clip whose bones never move, stored as numBones transforms in the
+		/// samplePose layout, or 0 if the clip is animated. Samplers copy or blend this pose instead of decompressing the transform tracks.</summary>
+		int staticPoseOffset;
+		/// <summary>The number of bones in the clip</summary>
+		int numBones;
+		/// <summary>The offset in bytes of the default pose the clip was compressed with, stored as numBones transforms in the samplePose
+		/// layout, or 0 if the clip uses the identity default pose or is static. Samplers read stripped default sub-tracks from this pose.</summary>
+		int defaultPoseOffset;
+		/// <summary>Always ACL_UNITY_COMPRESSED_CLIP_LAYOUT_TAG. Identifies the header layout, and keeps the parts which follow the header 16-byte aligned.</summary>
+		int layoutTag;
+	};
+}
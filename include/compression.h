@@ -3,9 +3,154 @@
 #define ACL_NO_ALLOCATOR_TRACKING
 
 #include "acl_unity_defines.h"
+#include "compressed_clip.h"
+
+#include <cstddef>
 
 extern "C"
 {
+	/// <summary>
+	/// Callbacks used to route compression memory into caller-owned allocators such as arenas
+	/// </summary>
+	/// <remarks>
+	/// The callbacks may be invoked concurrently from multiple threads when used with the batch, tuned, or asynchronous compression functions.
+	/// Every allocation made during compression is released through deallocate except for the returned compressed buffers,
+	/// which must be disposed with disposeCompressedTracksBufferWithAllocator using the same callbacks, or simply kept if the allocator is an arena.
+	/// ACL allocates the compressed buffer through the same allocator as its temporaries, so results cannot be routed separately into caller memory
+	/// such as a BlobAsset under construction. Compressed tracks only contain relative offsets, so a plain copy of a returned buffer is valid for sampling.
+	/// </remarks>
+	struct AllocatorCallbacks
+	{
+		/// <summary>
+		/// Allocates size bytes aligned to alignment bytes and returns the memory, which must not be nullptr
+		/// </summary>
+		void* (*allocate)(void* userData, size_t size, size_t alignment);
+
+		/// <summary>
+		/// Deallocates memory previously returned by allocate, where size matches the size passed to allocate
+		/// </summary>
+		void (*deallocate)(void* userData, void* ptr, size_t size);
+
+		/// <summary>
+		/// An arbitrary value passed to each callback, such as an arena handle
+		/// </summary>
+		void* userData;
+	};
+
+	/// <summary>
+	/// Statistics describing the result of compressing a single clip
+	/// </summary>
+	/// <remarks>
+	/// Sub-track counts are only written for skeleton clips and are zero for scalar clips.
+	/// Default sub-tracks are stripped entirely, constant sub-tracks store a single sample, and only animated sub-tracks store per-sample data.
+	/// </remarks>
+	struct CompressionStatistics
+	{
+		/// <summary>The wall time spent building, pre-processing, and compressing the tracks, excluding error measurement</summary>
+		float compressionTimeInSeconds;
+		/// <summary>The largest error measured by decompressing every sample, using the same error metric as compression</summary>
+		float maxError;
+		/// <summary>The sample time in seconds at which maxError was measured</summary>
+		float maxErrorTime;
+		/// <summary>The bone or scalar track index at which maxError was measured</summary>
+		int   maxErrorBone;
+		/// <summary>The size of the uncompressed input samples</summary>
+		int   rawSizeInBytes;
+		int   compressedSizeInBytes;
+		int   numSegments;
+		int   numAnimatedRotationSubTracks;
+		int   numAnimatedTranslationSubTracks;
+		int   numAnimatedScaleSubTracks;
+		int   numConstantRotationSubTracks;
+		int   numConstantTranslationSubTracks;
+		int   numConstantScaleSubTracks;
+		int   numDefaultRotationSubTracks;
+		int   numDefaultTranslationSubTracks;
+		int   numDefaultScaleSubTracks;
+	};
+
+	/// <summary>
+	/// Optional advanced settings for the compression functions which accept them.
+	/// Zero-initialize this struct to get the same behavior as the functions without options, then set only the fields you need.
+	/// </summary>
+	struct CompressionOptions
+	{
+		/// <summary>
+		/// An optional array of numBones radii, where each radius is the distance in Unity units from the bone to the furthest
+		/// skinned vertex it influences in the bind pose. When provided, each bone's error shell distance is computed as the largest
+		/// of its own radius and the radius of each descendant plus the length of the bone chain leading to it.
+		/// Bones with no skinned vertices in their entire subtree fall back to sampledErrorDistanceFromBone.
+		/// Pass nullptr to use sampledErrorDistanceFromBone for all bones.
+		/// </summary>
+		const float* boneRadii;
+
+		/// <summary>
+		/// Optional callbacks which receive all allocations made during compression, including the returned compressed buffers.
+		/// Pass nullptr to use the system allocator. The struct is copied by beginCompressSkeletonClip, but the callbacks must remain valid until endCompression returns.
+		/// </summary>
+		const AllocatorCallbacks* allocator;
+
+		/// <summary>
+		/// The layout of aosClipData for the skeleton compression functions. sampledScales is always frame-major regardless of this value.
+		/// 0 = bone-major AOS as documented by compressSkeletonClip.
+		/// 1 = frame-major AOS, where each bone uses the same 12 floats as bone-major AOS, but all bones for sample 0 come first, then all bones for sample 1, and so on.
+		/// 2 = SOA, where aosClipData is 11 consecutive streams of numSamples * numBones floats in the order
+		/// r.x, r.y, r.z, r.w, t.x, t.y, t.z, s.x, s.y, s.z, u. Each stream is frame-major.
+		/// Frame-major data is read in place. SOA data is transposed natively into a temporary AOS copy, which is always pre-processed in place.
+		/// </summary>
+		int clipDataLayout;
+
+		/// <summary>
+		/// An optional struct which receives statistics about the compressed clip. Measuring the error decompresses every sample,
+		/// so only request statistics when needed. Asynchronous compression ignores this option,
+		/// and compressSkeletonClipBatch uses SkeletonClipDescriptor.outStatistics instead.
+		/// </summary>
+		CompressionStatistics* outStatistics;
+
+		/// <summary>
+		/// The number of samples ACL aims to place in each segment of skeleton clips, or 0 for the ACL default of 16.
+		/// Each sample decodes the segment containing it, so smaller segments touch fewer bytes per sample at the cost of more per-segment headers.
+		/// Scalar compression ignores this option.
+		/// </summary>
+		int idealSamplesPerSegment;
+
+		/// <summary>
+		/// The maximum number of samples in each segment of skeleton clips, or 0 for the ACL default of 31.
+		/// Values below the ideal number of samples per segment, including the default, are raised to match it.
+		/// Scalar compression ignores this option.
+		/// </summary>
+		int maxSamplesPerSegment;
+
+		/// <summary>
+		/// When non-zero, skeleton clips are compressed so that their least important keyframes can later be moved into a streaming
+		/// database with buildSkeletonClipDatabase. Such clips still sample normally on their own until they are bound to a database.
+		/// Scalar compression ignores this option.
+		/// </summary>
+		int enableDatabaseSupport;
+
+		/// <summary>
+		/// The proportion, between 0 and 1, of each skeleton clip's least important keyframes to strip, or 0 to not strip by proportion.
+		/// Keyframes are ranked by how much error removing them introduces, and stripped keyframes are interpolated from their neighbors.
+		/// Scalar compression ignores this option.
+		/// </summary>
+		float keyframeStrippingProportion;
+
+		/// <summary>
+		/// Keyframes whose removal introduces less error than this distance in Unity units are stripped, or 0 to not strip by threshold.
+		/// When both this and keyframeStrippingProportion are set, keyframes matching either are stripped.
+		/// Use CompressionStatistics.maxError to measure the accuracy of the stripped clip. Scalar compression ignores this option.
+		/// </summary>
+		float keyframeStrippingThreshold;
+
+		/// <summary>
+		/// An optional default pose of numBones transforms in the samplePose layout, usually the bind pose. Rotation, translation, and
+		/// stretch sub-tracks which never leave their default value are stripped from the compressed data. Pass nullptr to use the identity.
+		/// Clips compressed with a default pose must be sampled with samplePoseWithDefaults or samplePoseSkipDefaults, or as a combined clip,
+		/// which stores the default pose itself. The uniform scale is stored separately and ignores this option.
+		/// </summary>
+		const float* defaultPose;
+	};
+
 	/// <summary>
 	/// Compresses a skeletal animation clip
 	/// </summary>
@@ -51,6 +196,380 @@ extern "C"
 											 int*                outCompressedSizeInBytes,
 	                                         float*              sampledScales);
 
+	/// <summary>
+	/// Compresses a skeletal animation clip using additional options
+	/// </summary>
+	/// <param name="options">Additional compression options, or nullptr to behave identically to compressSkeletonClip</param>
+	/// <remarks>
+	/// All other parameters and the returned buffer behave identically to compressSkeletonClip.
+	/// </remarks>
+	ACL_UNITY_API void* compressSkeletonClipWithOptions(const signed short*       parentIndices,
+														signed short              numBones,
+														signed short              compressionLevel,
+														const float*              aosClipData,
+														int                       numSamples,
+														float                     sampleRate,
+														float                     maxDistanceError,
+														float                     sampledErrorDistanceFromBone,
+														int*                      outCompressedSizeInBytes,
+														float*                    sampledScales,
+														const CompressionOptions* options);
+
+	/// <summary>
+	/// Compresses a skeletal animation clip using additional options, consuming the raw clip data
+	/// </summary>
+	/// <param name="aosClipData">The raw clip data, which ACL references directly and pre-processes in place.
+	/// Its contents are unspecified after this function returns.</param>
+	/// <remarks>
+	/// All other parameters and the returned buffer behave identically to compressSkeletonClipWithOptions.
+	/// Referencing the samples instead of copying them removes a full copy of the raw clip from peak memory usage.
+	/// SOA data is always transposed into a temporary copy, so it is left unchanged.
+	/// </remarks>
+	ACL_UNITY_API void* compressSkeletonClipInPlace(const signed short*       parentIndices,
+													signed short              numBones,
+													signed short              compressionLevel,
+													float*                    aosClipData,
+													int                       numSamples,
+													float                     sampleRate,
+													float                     maxDistanceError,
+													float                     sampledErrorDistanceFromBone,
+													int*                      outCompressedSizeInBytes,
+													float*                    sampledScales,
+													const CompressionOptions* options);
+
+	/// <summary>
+	/// Compresses a skeletal animation clip with the smallest maxDistanceError whose compressed size fits within a budget
+	/// </summary>
+	/// <param name="compressionLevel">The starting level of compression. If the budget cannot be met at maxDistanceError, higher levels are tried up to 4.
+	/// The automatic level 100 is never changed.</param>
+	/// <param name="targetSizeInBytes">The compressed size budget in bytes. Pass 0 to use targetBytesPerSecond instead.</param>
+	/// <param name="targetBytesPerSecond">The compressed size budget per second of clip duration, used when targetSizeInBytes is 0</param>
+	/// <param name="minDistanceError">The smallest maxDistanceError the search may choose. Clips which fit the budget at this error are not searched further.</param>
+	/// <param name="maxDistanceError">The largest maxDistanceError the search may choose</param>
+	/// <param name="maxIterations">The maximum number of bisection steps between minDistanceError and maxDistanceError. Each step compresses the clip once.</param>
+	/// <param name="outAchievedDistanceError">Receives the maxDistanceError used to produce the returned buffer. May be nullptr.</param>
+	/// <remarks>
+	/// All other parameters and the returned buffer behave identically to compressSkeletonClipWithOptions.
+	/// 
+	/// The raw tracks are built and pre-processed once and reused by every iteration. The search bisects in log space, since
+	/// useful errors span several orders of magnitude. If the clip does not fit the budget even at maxDistanceError and the
+	/// highest compression level, the buffer compressed at maxDistanceError is returned and outCompressedSizeInBytes exceeds the budget.
+	/// When both budgets are 0, the clip is compressed once at maxDistanceError.
+	/// </remarks>
+	ACL_UNITY_API void* compressSkeletonClipToBudget(const signed short*       parentIndices,
+													 signed short              numBones,
+													 signed short              compressionLevel,
+													 const float*              aosClipData,
+													 int                       numSamples,
+													 float                     sampleRate,
+													 int                       targetSizeInBytes,
+													 float                     targetBytesPerSecond,
+													 float                     minDistanceError,
+													 float                     maxDistanceError,
+													 int                       maxIterations,
+													 float                     sampledErrorDistanceFromBone,
+													 int*                      outCompressedSizeInBytes,
+													 float*                    outAchievedDistanceError,
+													 float*                    sampledScales,
+													 const CompressionOptions* options);
+
+	/// <summary>
+	/// A set of compression settings evaluated by compressSkeletonClipTuned
+	/// </summary>
+	struct CompressionCandidate
+	{
+		/// <summary>The level of compression to apply. 0 = lowest, fastest; 4 = highest, slower; 100 = automatic</summary>
+		signed short compressionLevel;
+		/// <summary>The number of samples ACL aims to place in each segment, or 0 for CompressionOptions.idealSamplesPerSegment</summary>
+		int          idealSamplesPerSegment;
+		/// <summary>The maximum number of samples in each segment, or 0 for CompressionOptions.maxSamplesPerSegment. Raised to the ideal size if lower.</summary>
+		int          maxSamplesPerSegment;
+	};
+
+	/// <summary>
+	/// The measured outcome of a single CompressionCandidate
+	/// </summary>
+	struct CompressionCandidateResult
+	{
+		int   compressedSizeInBytes;
+		/// <summary>The largest error measured by decompressing every sample</summary>
+		float maxError;
+		/// <summary>The average wall time of sampling a single pose from the compressed buffer with the sampler it requires</summary>
+		float decodeTimeInNanoseconds;
+		/// <summary>The number of segments ACL split the clip into</summary>
+		int   numSegments;
+	};
+
+	/// <summary>
+	/// Compresses a skeletal animation clip with each candidate setting and keeps the one with the best trade-off between size and decode time
+	/// </summary>
+	/// <param name="candidates">An array of numCandidates settings to evaluate</param>
+	/// <param name="numCandidates">The number of candidates</param>
+	/// <param name="bytesPerDecodeNanosecond">How many compressed bytes the caller would spend to save one nanosecond per sampled pose.
+	/// The candidate with the smallest compressedSizeInBytes + bytesPerDecodeNanosecond * decodeTimeInNanoseconds is chosen. Pass 0 to choose the smallest.</param>
+	/// <param name="numDecodes">The number of poses sampled and timed per candidate, spread evenly across the clip</param>
+	/// <param name="coldCache">When non-zero, the CPU caches are flushed before each timed decode. Use this to model many characters sampling different clips.</param>
+	/// <param name="maxThreads">The maximum number of threads to compress candidates with, including the calling thread. Pass 0 to use all available cores.</param>
+	/// <param name="outResults">An array of numCandidates results which receives the measurements of each candidate. May be nullptr.</param>
+	/// <param name="outChosenCandidate">Receives the index of the chosen candidate. May be nullptr.</param>
+	/// <remarks>
+	/// All other parameters and the returned buffer behave identically to compressSkeletonClipWithOptions, and every candidate is compressed to
+	/// the same maxDistanceError. Candidates compress in parallel, but decodes are timed serially on the calling thread. Timings are only
+	/// meaningful on the target hardware.
+	/// 
+	/// Decodes use samplePoseWithDefaults when options->defaultPose is set and samplePose otherwise. When sampledScales is provided,
+	/// the scales are compressed once into scale tracks which every timed decode samples as well, so that timings include them.
+	/// 
+	/// Rotation, translation, and scale formats are not candidates, since the runtime decompression settings only support the variable formats.
+	/// Currently compression levels 2 and below are identical.
+	/// </remarks>
+	ACL_UNITY_API void* compressSkeletonClipTuned(const signed short*           parentIndices,
+												  signed short                  numBones,
+												  const float*                  aosClipData,
+												  int                           numSamples,
+												  float                         sampleRate,
+												  float                         maxDistanceError,
+												  float                         sampledErrorDistanceFromBone,
+												  int*                          outCompressedSizeInBytes,
+												  float*                        sampledScales,
+												  const CompressionOptions*     options,
+												  const CompressionCandidate*   candidates,
+												  int                           numCandidates,
+												  float                         bytesPerDecodeNanosecond,
+												  int                           numDecodes,
+												  int                           coldCache,
+												  int                           maxThreads,
+												  CompressionCandidateResult*   outResults,
+												  int*                          outChosenCandidate);
+
+	/// <summary>
+	/// Measures the compressed size and decode cost of a skeletal animation clip for each of several segment sizes
+	/// </summary>
+	/// <param name="idealSamplesPerSegment">An array of numSegmentSizes ideal segment sizes to measure. Each is paired with a maximum segment size of twice the ideal minus one, matching ACL's defaults.</param>
+	/// <param name="numSegmentSizes">The number of segment sizes to measure</param>
+	/// <param name="numDecodes">The number of poses sampled and timed per segment size, spread evenly across the clip</param>
+	/// <param name="coldCache">When non-zero, the CPU caches are flushed before each timed decode</param>
+	/// <param name="maxThreads">The maximum number of threads to compress with, including the calling thread. Pass 0 to use all available cores.</param>
+	/// <param name="outResults">An array of numSegmentSizes results which receives the measurements for each segment size</param>
+	/// <remarks>
+	/// All other parameters behave identically to compressSkeletonClipWithOptions, except that options->outStatistics is ignored.
+	/// No compressed buffers are returned. Once a segment size is chosen, pass it through CompressionOptions when compressing.
+	/// </remarks>
+	ACL_UNITY_API void benchmarkSkeletonClipSegmentSizes(const signed short*         parentIndices,
+														 signed short                numBones,
+														 signed short                compressionLevel,
+														 const float*                aosClipData,
+														 int                         numSamples,
+														 float                       sampleRate,
+														 float                       maxDistanceError,
+														 float                       sampledErrorDistanceFromBone,
+														 float*                      sampledScales,
+														 const CompressionOptions*   options,
+														 const int*                  idealSamplesPerSegment,
+														 int                         numSegmentSizes,
+														 int                         numDecodes,
+														 int                         coldCache,
+														 int                         maxThreads,
+														 CompressionCandidateResult* outResults);
+
+	/// <summary>
+	/// Compresses a skeletal animation clip together with its uniform scales into a single blob
+	/// </summary>
+	/// <param name="maxUniformScaleError">The maximum allowed deviation of each uniform scale value from the source animation</param>
+	/// <param name="uniformScaleTolerance">If every uniform scale in the clip is within this distance of 1, no scale tracks are stored</param>
+	/// <param name="outCompressedSizeInBytes">This function writes the size of the whole blob in bytes to this variable.</param>
+	/// <returns>A pointer to a 16 byte aligned blob which starts with a CompressedClipHeader. The caller owns the memory and must dispose it with disposeCompressedClip.</returns>
+	/// <remarks>
+	/// All other parameters behave identically to compressSkeletonClipWithOptions. The uniform scales are read from the raw clip data,
+	/// compressed, and sampled back internally so that the transform error accounts for the lossy scales, replacing the separate
+	/// compressScalarsClip and sampledScales round trip. The statistics in options describe the transform tracks.
+	/// 
+	/// Sample the blob with the sampling functions which accept a compressed clip, or pass the parts located by the header offsets
+	/// to the regular sampling functions. Pass nullptr for the scale tracks when scaleTracksOffset is 0.
+	/// 
+	/// When no transform sub-track is animated and every uniform scale is constant, the blob also stores the decompressed pose and
+	/// sets staticPoseOffset, so that the sampling functions which accept a compressed clip copy it instead of decompressing.
+	/// </remarks>
+	ACL_UNITY_API void* compressSkeletonClipWithScales(const signed short*       parentIndices,
+													   signed short              numBones,
+													   signed short              compressionLevel,
+													   const float*              aosClipData,
+													   int                       numSamples,
+													   float                     sampleRate,
+													   float                     maxDistanceError,
+													   float                     sampledErrorDistanceFromBone,
+													   float                     maxUniformScaleError,
+													   float                     uniformScaleTolerance,
+													   int*                      outCompressedSizeInBytes,
+													   const CompressionOptions* options);
+
+	/// <summary>
+	/// Compresses a skeletal animation clip together with its uniform scales and scalar curves into a single blob
+	/// </summary>
+	/// <param name="numCurves">The number of scalar curve tracks to compress. Pass 0 if the clip has no curves.</param>
+	/// <param name="curveClipData">The curve samples laid out as documented by compressScalarsClip, sharing numSamples and sampleRate with the skeleton</param>
+	/// <param name="curveMaxErrors">An array specifying the maximum allowed deviation of each curve value from the source animation</param>
+	/// <remarks>
+	/// All other parameters and the returned blob behave identically to compressSkeletonClipWithScales. The curves are stored in the
+	/// part located by scalarTracksOffset and may be sampled together with the pose by samplePoseAndCurvesFromClip.
+	/// </remarks>
+	ACL_UNITY_API void* compressSkeletonClipWithCurves(const signed short*       parentIndices,
+													   signed short              numBones,
+													   signed short              compressionLevel,
+													   const float*              aosClipData,
+													   int                       numSamples,
+													   float                     sampleRate,
+													   float                     maxDistanceError,
+													   float                     sampledErrorDistanceFromBone,
+													   float                     maxUniformScaleError,
+													   float                     uniformScaleTolerance,
+													   signed short              numCurves,
+													   const float*              curveClipData,
+													   float*                    curveMaxErrors,
+													   int*                      outCompressedSizeInBytes,
+													   const CompressionOptions* options);
+
+	/// <summary>
+	/// Describes a single clip compressed by compressSkeletonClipBatch. Each field matches the compressSkeletonClip parameter of the same name.
+	/// </summary>
+	struct SkeletonClipDescriptor
+	{
+		const float*           aosClipData;
+		float*                 sampledScales;
+		int                    numSamples;
+		float                  sampleRate;
+		float                  maxDistanceError;
+		float                  sampledErrorDistanceFromBone;
+		signed short           compressionLevel;
+		/// <summary>An optional struct which receives statistics about this clip, or nullptr</summary>
+		CompressionStatistics* outStatistics;
+	};
+
+	/// <summary>
+	/// Compresses multiple skeletal animation clips which share a skeleton in parallel
+	/// </summary>
+	/// <param name="parentIndices">An array of indices to the corresponding parent bone.
+	/// If the index is itself, it has no parent.</param>
+	/// <param name="numBones">The number of bones in the skeleton</param>
+	/// <param name="clips">An array of numClips clip descriptors</param>
+	/// <param name="numClips">The number of clips to compress</param>
+	/// <param name="options">Additional compression options applied to every clip, or nullptr</param>
+	/// <param name="maxThreads">The maximum number of threads to compress with, including the calling thread. Pass 0 to use all available cores.</param>
+	/// <param name="outCompressedBuffers">An array of numClips pointers which receives the compressed buffer of each clip</param>
+	/// <param name="outCompressedSizesInBytes">An array of numClips ints which receives the compressed size of each clip</param>
+	/// <remarks>
+	/// Each output buffer is identical to what compressSkeletonClipWithOptions would return for the same clip and must be disposed
+	/// individually with disposeCompressedTracksBuffer. This function blocks until all clips are compressed.
+	///
+	/// Parallelism is only across clips. ACL 2.1 optimizes the bit rates of every segment of a clip inside a single compress_track_list call
+	/// and exposes no way to compress segments separately and stitch them, so a single long clip always compresses on one thread.
+	/// </remarks>
+	ACL_UNITY_API void compressSkeletonClipBatch(const signed short*           parentIndices,
+												 signed short                  numBones,
+												 const SkeletonClipDescriptor* clips,
+												 int                           numClips,
+												 const CompressionOptions*     options,
+												 int                           maxThreads,
+												 void**                        outCompressedBuffers,
+												 int*                          outCompressedSizesInBytes);
+
+	/// <summary>
+	/// Starts compressing a skeletal animation clip on a background thread
+	/// </summary>
+	/// <returns>A handle to the compression job. The handle must be released by endCompression, including after cancelCompression.</returns>
+	/// <remarks>
+	/// All parameters behave identically to compressSkeletonClipWithOptions.
+	/// All input data is copied before this function returns, so the caller may release it immediately.
+	/// </remarks>
+	ACL_UNITY_API void* beginCompressSkeletonClip(const signed short*       parentIndices,
+												  signed short              numBones,
+												  signed short              compressionLevel,
+												  const float*              aosClipData,
+												  int                       numSamples,
+												  float                     sampleRate,
+												  float                     maxDistanceError,
+												  float                     sampledErrorDistanceFromBone,
+												  float*                    sampledScales,
+												  const CompressionOptions* options);
+
+	/// <summary>
+	/// Queries the progress of a compression job started by beginCompressSkeletonClip without blocking
+	/// </summary>
+	/// <param name="compressionJob">The handle returned by beginCompressSkeletonClip</param>
+	/// <param name="outStage">Receives the stage the job is in. May be nullptr.
+	/// 0 = queued, 1 = building tracks, 2 = pre-processing, 3 = compressing, 4 = finished</param>
+	/// <returns>1 if the job has finished and endCompression will not block, otherwise 0</returns>
+	/// <remarks>
+	/// Progress is reported by stage only rather than as a count of compressed segments, since ACL 2.1 optimizes all segments
+	/// inside a single call without reporting progress. Compressing usually takes most of the time.
+	/// </remarks>
+	ACL_UNITY_API int pollCompression(void* compressionJob, int* outStage);
+
+	/// <summary>
+	/// Requests that a compression job started by beginCompressSkeletonClip stop early
+	/// </summary>
+	/// <param name="compressionJob">The handle returned by beginCompressSkeletonClip. It remains valid and must still be released by endCompression.</param>
+	/// <remarks>
+	/// This function returns immediately. A queued job never starts, and a clip which is already compressing stops measuring error,
+	/// so ACL accepts its first choice for every remaining decision and finishes shortly after. Use pollCompression to wait without blocking.
+	/// </remarks>
+	ACL_UNITY_API void cancelCompression(void* compressionJob);
+
+	/// <summary>
+	/// Retrieves the results of a compression job started by beginCompressSkeletonClip and releases the handle
+	/// </summary>
+	/// <param name="compressionJob">The handle returned by beginCompressSkeletonClip. It is invalid after this call.</param>
+	/// <param name="outCompressedSizeInBytes">This function writes the number of bytes of compressed animation to this variable.</param>
+	/// <returns>The compressed buffer, identical to what compressSkeletonClipWithOptions returns for the same inputs,
+	/// or nullptr with a size of 0 if the job was cancelled</returns>
+	/// <remarks>
+	/// This function blocks if the job has not finished. The result of a cancelled job is disposed before this function returns,
+	/// so allocator callbacks passed to beginCompressSkeletonClip are never used after it returns.
+	/// </remarks>
+	ACL_UNITY_API void* endCompression(void* compressionJob, int* outCompressedSizeInBytes);
+
+	/// <summary>
+	/// Decompresses every keyframe of a compressed skeletal animation clip and measures its error against the raw clip
+	/// </summary>
+	/// <param name="parentIndices">The parent index of each bone, as passed to compression</param>
+	/// <param name="numBones">The number of bones in the skeleton</param>
+	/// <param name="aosClipData">The raw clip data in the layout specified by options->clipDataLayout, as passed to compression</param>
+	/// <param name="numSamples">The number of uniformly sampled keyframe poses in the raw clip</param>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="sampledErrorDistanceFromBone">The shell distance used when options->boneRadii is not provided, as passed to compression</param>
+	/// <param name="options">The options passed to compression, or nullptr. Only the raw clip layout, bone radii, default pose, and allocator are used.</param>
+	/// <param name="maxThreads">The maximum number of threads to measure with, including the calling thread. Pass 0 to use all available cores.</param>
+	/// <param name="outPerBoneMaxErrors">An array of numBones floats which receives the largest error of each bone across all keyframes. May be nullptr.</param>
+	/// <param name="outPerSampleMaxErrors">An array of numSamples floats which receives the largest error of any bone at each keyframe. May be nullptr.</param>
+	/// <param name="numHistogramBuckets">The number of histogram buckets per bone in outPerBoneHistograms</param>
+	/// <param name="histogramMaxError">The upper bound of the histogram. Buckets evenly divide 0 to histogramMaxError, and the last bucket also counts every larger error.</param>
+	/// <param name="outPerBoneHistograms">An array of numBones * numHistogramBuckets ints which receives, for each bone in turn, the number of keyframes
+	/// whose error fell in each bucket. May be nullptr.</param>
+	/// <param name="outWorstBone">Receives the bone index at which the largest error was measured. May be nullptr.</param>
+	/// <param name="outWorstSample">Receives the keyframe index at which the largest error was measured. May be nullptr.</param>
+	/// <returns>The largest error measured across all bones and keyframes</returns>
+	/// <remarks>
+	/// Errors are the distance between raw and lossy object space shell points, identical to the metric used during compression.
+	/// Keyframes are decompressed by rounding to the nearest sample so that no interpolation error is introduced.
+	/// </remarks>
+	ACL_UNITY_API float measureSkeletonClipError(const signed short*       parentIndices,
+												 signed short              numBones,
+												 const float*              aosClipData,
+												 int                       numSamples,
+												 const void*               compressedTransformTracks,
+												 const void*               compressedScaleTracks,
+												 float                     sampledErrorDistanceFromBone,
+												 const CompressionOptions* options,
+												 int                       maxThreads,
+												 float*                    outPerBoneMaxErrors,
+												 float*                    outPerSampleMaxErrors,
+												 int                       numHistogramBuckets,
+												 float                     histogramMaxError,
+												 int*                      outPerBoneHistograms,
+												 int*                      outWorstBone,
+												 int*                      outWorstSample);
+
 	/// <summary>
 	/// Compresses an animation clip containing multiple scalar values (tracks)
 	/// </summary>
@@ -76,9 +595,84 @@ extern "C"
 											float*		 maxErrors, 
 											int*		 outCompressedSizeInBytes);
 	
+	/// <summary>
+	/// Compresses an animation clip containing multiple scalar values (tracks) using additional options
+	/// </summary>
+	/// <param name="options">Additional compression options, or nullptr to behave identically to compressScalarsClip. Skeleton-specific options are ignored.</param>
+	/// <remarks>
+	/// All other parameters and the returned buffer behave identically to compressScalarsClip.
+	/// </remarks>
+	ACL_UNITY_API void* compressScalarsClipWithOptions(signed short              numTracks,
+													   signed short              compressionLevel,
+													   const float*              clipData,
+													   int                       numSamples,
+													   float                     sampleRate,
+													   float*                    maxErrors,
+													   int*                      outCompressedSizeInBytes,
+													   const CompressionOptions* options);
+	
+	/// <summary>
+	/// Moves the least important keyframes of many skeleton clips into a streaming database with two quality tiers
+	/// </summary>
+	/// <param name="compressedTransformTracks">An array of numClips compressed transform tracks buffers, each compressed with CompressionOptions.enableDatabaseSupport set.
+	/// The buffers are only read and remain owned by the caller.</param>
+	/// <param name="numClips">The number of clips to place in the database</param>
+	/// <param name="mediumTierProportion">The proportion of each clip's movable keyframes placed in the medium importance tier, between 0 and 1</param>
+	/// <param name="lowTierProportion">The proportion of each clip's movable keyframes placed in the low importance tier, between 0 and 1.
+	/// mediumTierProportion + lowTierProportion must not exceed 1.</param>
+	/// <param name="outCompressedTransformTracks">An array of numClips pointers which receives a new compressed transform tracks buffer for each clip.
+	/// These buffers only contain the keyframes kept resident and must be sampled with a database context created from the returned database.
+	/// Dispose them with disposeCompressedTracksBufferWithAllocator.</param>
+	/// <param name="outDatabaseSizeInBytes">The size of the returned database in bytes</param>
+	/// <param name="outMediumTierBulkData">Receives the keyframes of the medium importance tier. Dispose with disposeDatabaseBuffer.</param>
+	/// <param name="outMediumTierSizeInBytes">The size of the medium importance tier in bytes</param>
+	/// <param name="outLowTierBulkData">Receives the keyframes of the low importance tier. Dispose with disposeDatabaseBuffer.</param>
+	/// <param name="outLowTierSizeInBytes">The size of the low importance tier in bytes</param>
+	/// <param name="allocatorCallbacks">Optional callbacks which receive all allocations, including every returned buffer. Pass nullptr to use the system allocator.</param>
+	/// <returns>The database metadata, which must stay resident while any of its clips are sampled, or nullptr if the database could not be built.
+	/// Dispose with disposeDatabaseBuffer.</returns>
+	/// <remarks>
+	/// The tiers are returned separately from the database so that they can be stored apart from it and streamed in only when needed.
+	/// Keyframes are ranked by how much error removing them introduces, so the low importance tier holds the keyframes which matter least.
+	/// Sampling without a tier resident interpolates across its missing keyframes.
+	/// </remarks>
+	ACL_UNITY_API void* buildSkeletonClipDatabase(const void* const*        compressedTransformTracks,
+												  int                       numClips,
+												  float                     mediumTierProportion,
+												  float                     lowTierProportion,
+												  void**                    outCompressedTransformTracks,
+												  int*                      outDatabaseSizeInBytes,
+												  void**                    outMediumTierBulkData,
+												  int*                      outMediumTierSizeInBytes,
+												  void**                    outLowTierBulkData,
+												  int*                      outLowTierSizeInBytes,
+												  const AllocatorCallbacks* allocatorCallbacks);
+
 	/// <summary>
 	/// Disposes a buffer generated from one of the compression functions
 	/// </summary>
 	/// <param name="compressedTracksBuffer">The buffer to dispose</param>
 	ACL_UNITY_API void disposeCompressedTracksBuffer(void* compressedTracksBuffer);
+
+	/// <summary>
+	/// Disposes a buffer generated from one of the compression functions using the allocator callbacks it was compressed with
+	/// </summary>
+	/// <param name="compressedTracksBuffer">The buffer to dispose</param>
+	/// <param name="allocatorCallbacks">The callbacks passed in the CompressionOptions used to compress the buffer, or nullptr for the system allocator</param>
+	ACL_UNITY_API void disposeCompressedTracksBufferWithAllocator(void* compressedTracksBuffer, const AllocatorCallbacks* allocatorCallbacks);
+
+	/// <summary>
+	/// Disposes a combined clip blob generated by compressSkeletonClipWithScales or compressSkeletonClipWithCurves
+	/// </summary>
+	/// <param name="compressedClip">The blob to dispose</param>
+	/// <param name="allocatorCallbacks">The callbacks passed in the CompressionOptions used to compress the blob, or nullptr for the system allocator</param>
+	ACL_UNITY_API void disposeCompressedClip(void* compressedClip, const AllocatorCallbacks* allocatorCallbacks);
+
+	/// <summary>
+	/// Disposes a database or a database tier generated by buildSkeletonClipDatabase
+	/// </summary>
+	/// <param name="databaseBuffer">The buffer to dispose</param>
+	/// <param name="sizeInBytes">The size of the buffer reported by buildSkeletonClipDatabase</param>
+	/// <param name="allocatorCallbacks">The callbacks passed to buildSkeletonClipDatabase, or nullptr for the system allocator</param>
+	ACL_UNITY_API void disposeDatabaseBuffer(void* databaseBuffer, int sizeInBytes, const AllocatorCallbacks* allocatorCallbacks);
 }
\ No newline at end of file
@@ -0,0 +1,162 @@
+#pragma once
+
+#include "acl_unity_defines.h"
+
+extern "C"
+{
+	struct DatabaseStreamingStatistics
+	{
+		/// <summary>
+		/// The number of streamInDatabaseTier calls made for contexts of the file streamer
+		/// </summary>
+		int numStreamInRequests;
+
+		/// <summary>
+		/// The number of stream-in requests which found the whole tier already resident. The hit rate is numHits / numStreamInRequests.
+		/// </summary>
+		int numHits;
+
+		/// <summary>
+		/// The number of stream-in requests refused because the tier could not fit in the memory budget even after evicting every other tier
+		/// </summary>
+		int numRejectedRequests;
+
+		/// <summary>
+		/// The number of tiers streamed out to make room for other tiers
+		/// </summary>
+		int numEvictions;
+
+		/// <summary>
+		/// The number of completed file reads, including failed ones
+		/// </summary>
+		int numReads;
+
+		/// <summary>
+		/// The number of file reads which could not read the requested range. The tiers they were reading for stay streamed out.
+		/// </summary>
+		int numFailedReads;
+
+		/// <summary>
+		/// The total number of bytes read from the file
+		/// </summary>
+		long long bytesRead;
+
+		/// <summary>
+		/// The memory currently held by resident tiers, which never exceeds the memory budget
+		/// </summary>
+		long long residentSizeInBytes;
+
+		/// <summary>
+		/// The average time from a read being queued to its completion
+		/// </summary>
+		float averageReadLatencyInMilliseconds;
+
+		/// <summary>
+		/// The longest time from a read being queued to its completion
+		/// </summary>
+		float maxReadLatencyInMilliseconds;
+	};
+
+	/// <summary>
+	/// Creates a context which samples the clips of a database built by buildSkeletonClipDatabase with whichever tiers are resident
+	/// </summary>
+	/// <param name="compressedDatabase">The database returned by buildSkeletonClipDatabase. It must be 16 byte aligned and remain valid until the context is destroyed.</param>
+	/// <param name="mediumTierBulkData">The medium importance tier returned by buildSkeletonClipDatabase, or nullptr if it will never be streamed in</param>
+	/// <param name="mediumTierSizeInBytes">The size of the medium importance tier in bytes</param>
+	/// <param name="lowTierBulkData">The low importance tier returned by buildSkeletonClipDatabase, or nullptr if it will never be streamed in</param>
+	/// <param name="lowTierSizeInBytes">The size of the low importance tier in bytes</param>
+	/// <returns>A handle to the context, or nullptr if the database is invalid or a tier size is negative. Release it with destroyDatabaseContext.</returns>
+	/// <remarks>
+	/// Both tiers start streamed out. Streaming a tier in copies the requested part of it into memory owned by the context,
+	/// so the tier buffers passed here may live in memory which is cheap to keep around, such as a memory mapped file.
+	/// They must remain valid until the context is destroyed.
+	/// </remarks>
+	ACL_UNITY_API void* createDatabaseContext(const void* compressedDatabase, const void* mediumTierBulkData, int mediumTierSizeInBytes, const void* lowTierBulkData, int lowTierSizeInBytes);
+
+	/// <summary>
+	/// Opens a file containing database tiers and starts a worker thread which reads tiers from it as they are streamed in
+	/// </summary>
+	/// <param name="path">The path of the file containing the tiers</param>
+	/// <param name="memoryBudgetInBytes">The most memory the resident tiers of all contexts created with this streamer may use, or 0 for no limit</param>
+	/// <returns>A handle to the streamer, or nullptr if the file could not be opened. Release it with destroyDatabaseFileStreamer.</returns>
+	/// <remarks>
+	/// When a tier does not fit in the budget, tiers of the contexts whose tiers were least recently requested with streamInDatabaseTier
+	/// are streamed out first, low importance tiers before medium importance tiers.
+	/// Streaming requests for all contexts created with the same streamer must not be made concurrently.
+	/// </remarks>
+	ACL_UNITY_API void* createDatabaseFileStreamer(const char* path, long long memoryBudgetInBytes);
+
+	/// <summary>
+	/// Creates a context like createDatabaseContext, except that its tiers are read from the file of a file streamer
+	/// </summary>
+	/// <param name="databaseFileStreamer">The handle returned by createDatabaseFileStreamer</param>
+	/// <param name="compressedDatabase">The database returned by buildSkeletonClipDatabase. It must be 16 byte aligned and remain valid until the context is destroyed.</param>
+	/// <param name="mediumTierFileOffset">The offset in bytes of the medium importance tier within the file</param>
+	/// <param name="mediumTierSizeInBytes">The size of the medium importance tier in bytes</param>
+	/// <param name="lowTierFileOffset">The offset in bytes of the low importance tier within the file</param>
+	/// <param name="lowTierSizeInBytes">The size of the low importance tier in bytes</param>
+	/// <returns>A handle to the context, or nullptr if the database is invalid or a tier offset or size is negative.
+	/// Release it with destroyDatabaseContext before destroying the streamer.</returns>
+	/// <remarks>
+	/// Stream-in requests return as soon as the reads are queued. Poll isDatabaseTierStreamedIn to know when a tier has finished loading.
+	/// Chunks which have finished loading are used by sampling straight away.
+	/// </remarks>
+	ACL_UNITY_API void* createFileDatabaseContext(void*       databaseFileStreamer,
+												  const void* compressedDatabase,
+												  long long   mediumTierFileOffset,
+												  int         mediumTierSizeInBytes,
+												  long long   lowTierFileOffset,
+												  int         lowTierSizeInBytes);
+
+	/// <summary>
+	/// Retrieves the latency, hit rate, and memory counters of a file streamer since it was created
+	/// </summary>
+	/// <param name="databaseFileStreamer">The handle returned by createDatabaseFileStreamer</param>
+	/// <param name="outStatistics">The struct which receives the counters</param>
+	ACL_UNITY_API void getDatabaseFileStreamerStatistics(void* databaseFileStreamer, DatabaseStreamingStatistics* outStatistics);
+
+	/// <summary>
+	/// Stops the worker thread of a file streamer and closes its file. Every context created with it must be destroyed first.
+	/// </summary>
+	/// <param name="databaseFileStreamer">The handle returned by createDatabaseFileStreamer</param>
+	ACL_UNITY_API void destroyDatabaseFileStreamer(void* databaseFileStreamer);
+
+	/// <summary>
+	/// Makes the keyframes of a tier resident so that clips sample at a higher quality
+	/// </summary>
+	/// <param name="databaseContext">The handle returned by createDatabaseContext</param>
+	/// <param name="tier">1 = medium importance, 2 = low importance</param>
+	/// <param name="numChunks">The number of chunks of the tier to stream in, or 0 for the whole tier</param>
+	/// <returns>1 if the request completed or was dispatched, or 0 if the tier is invalid, already streaming, or does not fit in the file streamer's memory budget</returns>
+	/// <remarks>
+	/// Streaming must not happen while any clip of the database is being sampled. For contexts created with createFileDatabaseContext,
+	/// this includes the contexts whose tiers may be evicted to make room.
+	/// </remarks>
+	ACL_UNITY_API int streamInDatabaseTier(void* databaseContext, int tier, int numChunks);
+
+	/// <summary>
+	/// Releases the keyframes of a tier so that clips sample at a lower quality and use less memory
+	/// </summary>
+	/// <param name="databaseContext">The handle returned by createDatabaseContext</param>
+	/// <param name="tier">1 = medium importance, 2 = low importance</param>
+	/// <param name="numChunks">The number of chunks of the tier to stream out, or 0 for the whole tier</param>
+	/// <returns>1 if the request completed or was dispatched, or 0 if the tier is invalid or already streaming</returns>
+	/// <remarks>
+	/// Streaming must not happen while any clip of the database is being sampled.
+	/// </remarks>
+	ACL_UNITY_API int streamOutDatabaseTier(void* databaseContext, int tier, int numChunks);
+
+	/// <summary>
+	/// Queries whether every chunk of a tier is resident
+	/// </summary>
+	/// <param name="databaseContext">The handle returned by createDatabaseContext</param>
+	/// <param name="tier">1 = medium importance, 2 = low importance</param>
+	/// <returns>1 if the whole tier is resident, otherwise 0</returns>
+	ACL_UNITY_API int isDatabaseTierStreamedIn(const void* databaseContext, int tier);
+
+	/// <summary>
+	/// Destroys a database context and releases every resident tier
+	/// </summary>
+	/// <param name="databaseContext">The handle returned by createDatabaseContext</param>
+	ACL_UNITY_API void destroyDatabaseContext(void* databaseContext);
+}
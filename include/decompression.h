@@ -1,6 +1,7 @@
 #pragma once
 
 #include "acl_unity_defines.h"
+#include "compressed_clip.h"
 
 extern "C"
 {
@@ -21,6 +22,9 @@ extern "C"
 	/// floats 8-11: s.x, s.y, s.z, u
 	/// 
 	/// In total, each bone is 12 floats or 48 bytes long. So the first 12 float values correspond to bone 0, then next 12 values correspond to bone 1, ect.
+	/// 
+	/// Sub-tracks stripped by CompressionOptions.defaultPose are written as the identity, because the compressed tracks do not store the default pose.
+	/// Sample such clips with samplePoseWithDefaults or samplePoseSkipDefaults instead, or compress them as a combined clip.
 	/// </remarks>
 	ACL_UNITY_API void samplePose(const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float time, unsigned char keyframeInterpolationMode);
 
@@ -42,6 +46,8 @@ extern "C"
 	/// floats 8-11: s.x, s.y, s.z, u
 	/// 
 	/// In total, each bone is 12 floats or 48 bytes long. So the first 12 float values correspond to bone 0, then next 12 values correspond to bone 1, ect.
+	/// 
+	/// As with samplePose, sub-tracks stripped by CompressionOptions.defaultPose are blended as the identity.
 	/// </remarks>
 	ACL_UNITY_API void samplePoseBlendedFirst(const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
 
@@ -63,6 +69,8 @@ extern "C"
 	/// floats 8-11: s.x, s.y, s.z, u
 	/// 
 	/// In total, each bone is 12 floats or 48 bytes long. So the first 12 float values correspond to bone 0, then next 12 values correspond to bone 1, ect.
+	/// 
+	/// As with samplePose, sub-tracks stripped by CompressionOptions.defaultPose are accumulated as the identity.
 	/// </remarks>
 	ACL_UNITY_API void samplePoseBlendedAdd(const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
 
@@ -84,6 +92,8 @@ extern "C"
 	/// floats 8-11: s.x, s.y, s.z, u
 	/// 
 	/// In total, each bone is 12 floats or 48 bytes long. So the first 12 float values correspond to bone 0, then next 12 values correspond to bone 1, ect.
+	/// 
+	/// As with samplePose, sub-tracks stripped by CompressionOptions.defaultPose are written as the identity.
 	/// </remarks>
 	ACL_UNITY_API void samplePoseMasked(const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, const unsigned long long* mask, float time, unsigned char keyframeInterpolationMode);
 
@@ -106,6 +116,8 @@ extern "C"
 	/// floats 8-11: s.x, s.y, s.z, u
 	/// 
 	/// In total, each bone is 12 floats or 48 bytes long. So the first 12 float values correspond to bone 0, then next 12 values correspond to bone 1, ect.
+	/// 
+	/// As with samplePose, sub-tracks stripped by CompressionOptions.defaultPose are blended as the identity.
 	/// </remarks>
 	ACL_UNITY_API void samplePoseMaskedBlendedFirst(const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, const unsigned long long* mask, float blendFactor, float time, unsigned char keyframeInterpolationMode);
 
@@ -128,6 +140,8 @@ extern "C"
 	/// floats 8-11: s.x, s.y, s.z, u
 	/// 
 	/// In total, each bone is 12 floats or 48 bytes long. So the first 12 float values correspond to bone 0, then next 12 values correspond to bone 1, ect.
+	/// 
+	/// As with samplePose, sub-tracks stripped by CompressionOptions.defaultPose are accumulated as the identity.
 	/// </remarks>
 	ACL_UNITY_API void samplePoseMaskedBlendedAdd(const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, const unsigned long long* mask, float blendFactor, float time, unsigned char keyframeInterpolationMode);
 	
@@ -149,6 +163,8 @@ extern "C"
 	/// floats 8-11: s.x, s.y, s.z, u
 	/// 
 	/// In total, the bone is 12 floats or 48 bytes long.
+	/// 
+	/// As with samplePose, sub-tracks stripped by CompressionOptions.defaultPose are written as the identity.
 	/// </remarks>
 	ACL_UNITY_API void sampleBone(const void* compressedTransformTracks, const void* compressedScaleTracks, float* boneQvvs, int boneIndex, float time, unsigned char keyframeInterpolationMode);
 
@@ -233,4 +249,295 @@ extern "C"
 	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
 	/// <returns>The sampled value for the specified track</returns>
 	ACL_UNITY_API float sampleFloat(const void* compressedFloatTracks, int trackIndex, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a combined clip at the given sample time and stores it in AOS format
+	/// </summary>
+	/// <param name="compressedClip">The 16-byte aligned pointer to a blob starting with a CompressedClipHeader</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePose.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	/// <remarks>
+	/// The transform and scale parts are prefetched together before either is decompressed.
+	/// Clips with a static pose copy it without seeking, as do the blended variants and samplePoseAndCurvesFromClip.
+	/// Clips whose header has an unknown layout tag leave the output untouched, as do all other combined clip samplers.
+	/// </remarks>
+	ACL_UNITY_API void samplePoseFromClip(const void* compressedClip, float* aosOutputBuffer, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a combined clip at the given sample time and stores it in AOS format, scaling each result by the blend factor
+	/// </summary>
+	/// <param name="compressedClip">The 16-byte aligned pointer to a blob starting with a CompressedClipHeader</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePoseBlendedFirst.</param>
+	/// <param name="blendFactor">A scale factor to apply to all decompressed values. Rotations are left unnormalized.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	ACL_UNITY_API void samplePoseFromClipBlendedFirst(const void* compressedClip, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a combined clip at the given sample time, scales each value by the blend factor, and adds it to the existing value in the buffer in AOS format
+	/// </summary>
+	/// <param name="compressedClip">The 16-byte aligned pointer to a blob starting with a CompressedClipHeader</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be accumulated. The layout matches samplePoseBlendedAdd.</param>
+	/// <param name="blendFactor">A scale factor to apply to all decompressed values. Rotations are left unnormalized.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	ACL_UNITY_API void samplePoseFromClipBlendedAdd(const void* compressedClip, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the scalar curves of a combined clip at the given sample time and stores the results in the floatOutputBuffer
+	/// </summary>
+	/// <param name="compressedClip">The 16-byte aligned pointer to a blob starting with a CompressedClipHeader</param>
+	/// <param name="floatOutputBuffer">A pointer to the buffer where the decompressed sampled values should be stored.
+	/// Each curve stores a single float value at its respective index. Nothing is written if the clip has no curves.</param>
+	/// <param name="time">The time at which to sample the curves in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	ACL_UNITY_API void sampleCurvesFromClip(const void* compressedClip, float* floatOutputBuffer, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses both the pose and the scalar curves of a combined clip at the given sample time
+	/// </summary>
+	/// <param name="compressedClip">The 16-byte aligned pointer to a blob starting with a CompressedClipHeader</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePose.</param>
+	/// <param name="floatOutputBuffer">A pointer to the buffer where the decompressed curve values should be stored. Nothing is written if the clip has no curves.</param>
+	/// <param name="time">The time at which to sample the clip in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	/// <remarks>
+	/// All three parts are prefetched together before any of them is decompressed.
+	/// </remarks>
+	ACL_UNITY_API void samplePoseAndCurvesFromClip(const void* compressedClip, float* aosOutputBuffer, float* floatOutputBuffer, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a clip bound to a streaming database at the given sample time and stores it in AOS format
+	/// </summary>
+	/// <param name="databaseContext">The handle returned by createDatabaseContext for the database the clip was placed in</param>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to compressed tracks returned by buildSkeletonClipDatabase</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePose.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	/// <remarks>
+	/// Keyframes in tiers which are not resident are interpolated from the surrounding resident keyframes.
+	/// As with samplePose, sub-tracks stripped by CompressionOptions.defaultPose are written as the identity, here and in the blended variants.
+	/// </remarks>
+	ACL_UNITY_API void samplePoseWithDatabase(const void* databaseContext, const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a clip bound to a streaming database at the given sample time, scales each value by the blend factor, and stores it in AOS format
+	/// </summary>
+	/// <param name="databaseContext">The handle returned by createDatabaseContext for the database the clip was placed in</param>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to compressed tracks returned by buildSkeletonClipDatabase</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePoseBlendedFirst.</param>
+	/// <param name="blendFactor">A scale factor to apply to all decompressed values. Rotations are left unnormalized.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	ACL_UNITY_API void samplePoseWithDatabaseBlendedFirst(const void* databaseContext, const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a clip bound to a streaming database at the given sample time, scales each value by the blend factor, and adds it to the existing value in the buffer in AOS format
+	/// </summary>
+	/// <param name="databaseContext">The handle returned by createDatabaseContext for the database the clip was placed in</param>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to compressed tracks returned by buildSkeletonClipDatabase</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be accumulated. The layout matches samplePoseBlendedAdd.</param>
+	/// <param name="blendFactor">A scale factor to apply to all decompressed values. Rotations are left unnormalized.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	ACL_UNITY_API void samplePoseWithDatabaseBlendedAdd(const void* databaseContext, const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a clip compressed with CompressionOptions.defaultPose at the given sample time and stores it in AOS format
+	/// </summary>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="defaultPose">The default pose the clip was compressed with, as numBones transforms in the samplePose layout</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePose.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	/// <remarks>
+	/// Sub-tracks which were stripped because they matched the default pose are written from defaultPose.
+	/// </remarks>
+	ACL_UNITY_API void samplePoseWithDefaults(const void* compressedTransformTracks, const void* compressedScaleTracks, const float* defaultPose, float* aosOutputBuffer, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a clip compressed with CompressionOptions.defaultPose at the given sample time, scales each value by the blend factor, and stores it in AOS format
+	/// </summary>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="defaultPose">The default pose the clip was compressed with, as numBones transforms in the samplePose layout</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePoseBlendedFirst.</param>
+	/// <param name="blendFactor">A scale factor to apply to all decompressed values. Rotations are left unnormalized.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	ACL_UNITY_API void samplePoseWithDefaultsBlendedFirst(const void* compressedTransformTracks, const void* compressedScaleTracks, const float* defaultPose, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a clip compressed with CompressionOptions.defaultPose at the given sample time, scales each value by the blend factor, and adds it to the existing value in the buffer in AOS format
+	/// </summary>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="defaultPose">The default pose the clip was compressed with, as numBones transforms in the samplePose layout</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be accumulated. The layout matches samplePoseBlendedAdd.</param>
+	/// <param name="blendFactor">A scale factor to apply to all decompressed values. Rotations are left unnormalized.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	ACL_UNITY_API void samplePoseWithDefaultsBlendedAdd(const void* compressedTransformTracks, const void* compressedScaleTracks, const float* defaultPose, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose of a clip compressed with CompressionOptions.defaultPose at the given sample time into a buffer which already holds the default pose
+	/// </summary>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="aosOutputBuffer">A pointer to a buffer holding the default pose the clip was compressed with. The layout matches samplePose.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	/// <remarks>
+	/// Sub-tracks which were stripped because they matched the default pose are not written at all, which saves a store per sub-track
+	/// for rigs with many unanimated bones. Uniform scales are always written.
+	/// </remarks>
+	ACL_UNITY_API void samplePoseSkipDefaults(const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Returns the size in bytes of the init cache built by buildClipInitCache
+	/// </summary>
+	ACL_UNITY_API int getClipInitCacheSize();
+
+	/// <summary>
+	/// Returns the alignment in bytes required of the memory passed to buildClipInitCache
+	/// </summary>
+	ACL_UNITY_API int getClipInitCacheAlignment();
+
+	/// <summary>
+	/// Decodes the headers of a clip once into an init cache which the samplers accepting one use instead of decoding the headers on every call
+	/// </summary>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="outInitCache">A buffer of getClipInitCacheSize() bytes aligned to getClipInitCacheAlignment() in which the cache is built</param>
+	/// <returns>1 if the cache was built. 0 if outInitCache was misaligned, in which case nothing is written.</returns>
+	/// <remarks>
+	/// The cache holds live decompression state rather than plain data, so it is only valid in the process which built it and must be
+	/// released with destroyClipInitCache. ACL decompression contexts cannot be copied, so samplers seek the cache in place rather than
+	/// a copy of it. A cache is therefore mutable state which may only be sampled by one thread at a time and cannot be shared between
+	/// instances of a clip: keep one cache per playing clip instance. If the clip moves, the next sample patches the cached pointers.
+	/// Use benchmarkClipInitCache to check that the cache is worthwhile for a given clip.
+	/// The cached samplers write sub-tracks stripped by CompressionOptions.defaultPose as the identity, so they do not suit clips compressed with one.
+	/// </remarks>
+	ACL_UNITY_API int buildClipInitCache(const void* compressedTransformTracks, const void* compressedScaleTracks, void* outInitCache);
+
+	/// <summary>
+	/// Releases a cache built by buildClipInitCache. The memory itself remains owned by the caller.
+	/// </summary>
+	ACL_UNITY_API void destroyClipInitCache(void* initCache);
+
+	/// <summary>
+	/// Decompresses the pose at the given sample time like samplePose, using an init cache instead of decoding the clip headers
+	/// </summary>
+	/// <param name="initCache">The cache built by buildClipInitCache for this clip</param>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data the cache was built from, possibly moved since</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks the cache was built from, or nullptr if the cache was built without them.</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePose.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	/// <returns>1 if the pose was sampled. 0 if the cache was not built, or was built with a different presence of scale tracks,
+	/// in which case the output is left untouched.</returns>
+	/// <remarks>
+	/// Like samplePose, this cannot sample clips compressed with CompressionOptions.defaultPose correctly, and writes their stripped sub-tracks as the identity.
+	/// The blended variants share this restriction.
+	/// </remarks>
+	ACL_UNITY_API int samplePoseWithInitCache(void* initCache, const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose at the given sample time like samplePoseBlendedFirst, using an init cache instead of decoding the clip headers
+	/// </summary>
+	/// <param name="initCache">The cache built by buildClipInitCache for this clip</param>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data the cache was built from, possibly moved since</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks the cache was built from, or nullptr if the cache was built without them.</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be stored. The layout matches samplePoseBlendedFirst.</param>
+	/// <param name="blendFactor">A scale factor to apply to all decompressed values. Rotations are left unnormalized.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	/// <returns>1 if the pose was sampled, otherwise 0 as for samplePoseWithInitCache</returns>
+	ACL_UNITY_API int samplePoseWithInitCacheBlendedFirst(void* initCache, const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Decompresses the pose at the given sample time like samplePoseBlendedAdd, using an init cache instead of decoding the clip headers
+	/// </summary>
+	/// <param name="initCache">The cache built by buildClipInitCache for this clip</param>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data the cache was built from, possibly moved since</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks the cache was built from, or nullptr if the cache was built without them.</param>
+	/// <param name="aosOutputBuffer">A pointer to the buffer where the decompressed pose should be accumulated. The layout matches samplePoseBlendedAdd.</param>
+	/// <param name="blendFactor">A scale factor to apply to all decompressed values. Rotations are left unnormalized.</param>
+	/// <param name="time">The time at which to sample the pose in seconds</param>
+	/// <param name="keyframeInterpolationMode">The method used for interpolating between the two keyframes sampled: 
+	/// 0 = lerp, 1 = round to next sample, 2 = round to previous sample, 3 = round to nearest sample</param>
+	/// <returns>1 if the pose was sampled, otherwise 0 as for samplePoseWithInitCache</returns>
+	ACL_UNITY_API int samplePoseWithInitCacheBlendedAdd(void* initCache, const void* compressedTransformTracks, const void* compressedScaleTracks, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode);
+
+	/// <summary>
+	/// Measures the average time to sample a pose with samplePose and with samplePoseWithInitCache
+	/// </summary>
+	/// <param name="compressedTransformTracks">The 16-byte aligned pointer to the compressed tracks data</param>
+	/// <param name="compressedScaleTracks">The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</param>
+	/// <param name="numSamples">The number of poses sampled by each method, evenly spaced across the clip</param>
+	/// <param name="outInitializeNanoseconds">Receives the average nanoseconds per samplePose call, which initializes its contexts every call</param>
+	/// <param name="outInitCacheNanoseconds">Receives the average nanoseconds per samplePoseWithInitCache call on a single cache</param>
+	/// <remarks>
+	/// Both methods run a warm-up pass first, so the results describe warm caches. Timings are only meaningful on the target hardware.
+	/// </remarks>
+	ACL_UNITY_API void benchmarkClipInitCache(const void* compressedTransformTracks,
+											  const void* compressedScaleTracks,
+											  int         numSamples,
+											  float*      outInitializeNanoseconds,
+											  float*      outInitCacheNanoseconds);
+
+	/// <summary>
+	/// Describes a single pose sampled by samplePoseBatch
+	/// </summary>
+	struct PoseSampleRequest
+	{
+		/// <summary>The 16-byte aligned pointer to the compressed tracks data. Clips compressed with CompressionOptions.defaultPose are not supported.</summary>
+		const void*   compressedTransformTracks;
+		/// <summary>The 16-byte aligned pointer to the compressed scale tracks, or nullptr if all uniform scales are 1f.</summary>
+		const void*   compressedScaleTracks;
+		/// <summary>The buffer receiving the pose. The layout matches samplePose.</summary>
+		float*        aosOutputBuffer;
+		/// <summary>The time at which to sample the pose in seconds</summary>
+		float         time;
+		/// <summary>The blend factor used when blendMode is 1 or 2</summary>
+		float         blendFactor;
+		/// <summary>The keyframe interpolation mode, matching samplePose</summary>
+		unsigned char keyframeInterpolationMode;
+		/// <summary>0 = store like samplePose, 1 = blend like samplePoseBlendedFirst, 2 = accumulate like samplePoseBlendedAdd</summary>
+		unsigned char blendMode;
+	};
+
+	/// <summary>
+	/// Samples many poses, decompressing each distinct sample only once
+	/// </summary>
+	/// <param name="requests">An array of numRequests requests</param>
+	/// <param name="numRequests">The number of requests</param>
+	/// <remarks>
+	/// Requests sampling the same clip with the same mode at exactly the same time are decompressed once and then copied or blended
+	/// into each of their outputs with the same math as the regular samplers. Requests whose times differ are sampled separately,
+	/// even when they round to the same keyframe.
+	/// This suits crowds where many instances play the same clip in sync. Requests are applied in the order given,
+	/// so several of them may blend into the same output buffer.
+	/// Each request samples like samplePose, so sub-tracks stripped by CompressionOptions.defaultPose are written as the identity.
+	/// </remarks>
+	ACL_UNITY_API void samplePoseBatch(const PoseSampleRequest* requests, int numRequests);
 }
\ No newline at end of file
@@ -0,0 +1,357 @@
+#include "archive.h"
+#include "compressed_clip.h"
+
+#include "acl/core/compressed_tracks.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace acl;
+
+// Archive file layout, in native byte order:
+//   ArchiveHeader
+//   ArchiveEntry[numEntries], sorted by name hash
+//   Clip data, each clip starting at a 16 byte aligned offset from the start of the file
+namespace
+{
+	const uint32_t kArchiveMagic   = 0x41434c41;	// 'ACLA'
+	const uint32_t kArchiveVersion = 1;
+
+	const uint32_t kArchiveEntryFlagCompressedClip = 1;
+
+	struct ArchiveHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t numEntries;
+		uint32_t reserved;
+	};
+
+	struct ArchiveEntry
+	{
+		uint64_t nameHash;
+		uint64_t offset;
+		uint32_t sizeInBytes;
+		float    durationInSeconds;
+		uint32_t numTracks;
+		uint32_t flags;
+	};
+
+	static_assert(sizeof(ArchiveHeader) == 16, "The entries must stay 16 byte aligned");
+	static_assert(sizeof(ArchiveEntry) == 32, "The clip data must stay 16 byte aligned");
+
+	// Returns the compressed tracks stored at the given offset of a combined clip, or nullptr if they do not fit within it
+	const compressed_tracks* getClipPart(const void* clip, int offset, int totalSizeInBytes)
+	{
+		if (offset < static_cast<int>(sizeof(CompressedClipHeader)) || (offset & 15) != 0 || offset >= totalSizeInBytes)
+			return nullptr;
+		const compressed_tracks* tracks = make_compressed_tracks(static_cast<const uint8_t*>(clip) + offset);
+		if (tracks == nullptr || tracks->is_valid(false).any() || tracks->get_size() > static_cast<uint32_t>(totalSizeInBytes - offset))
+			return nullptr;
+		return tracks;
+	}
+
+	// Fills in everything but the name hash and offset. Returns false if the clip is not recognized or does not fit in maxSizeInBytes.
+	// Only headers are read, so the compressed data itself is not hashed.
+	bool describeClip(const void* clip, uint64_t maxSizeInBytes, ArchiveEntry& outEntry)
+	{
+		if (maxSizeInBytes < sizeof(CompressedClipHeader))
+			return false;
+
+		const compressed_tracks* tracks = make_compressed_tracks(clip);
+		outEntry.flags = 0;
+		if (tracks == nullptr)
+		{
+			// Combined clips start with their size just like compressed tracks, but never carry the compressed tracks tag
+			const CompressedClipHeader* header = static_cast<const CompressedClipHeader*>(clip);
+			if (header->layoutTag != ACL_UNITY_COMPRESSED_CLIP_LAYOUT_TAG)
+				return false;
+			if (header->totalSizeInBytes < static_cast<int>(sizeof(CompressedClipHeader)) || static_cast<uint64_t>(header->totalSizeInBytes) > maxSizeInBytes)
+				return false;
+			tracks = getClipPart(clip, header->transformTracksOffset, header->totalSizeInBytes);
+			if (tracks == nullptr)
+				return false;
+			if (header->scaleTracksOffset != 0 && getClipPart(clip, header->scaleTracksOffset, header->totalSizeInBytes) == nullptr)
+				return false;
+			if (header->scalarTracksOffset != 0 && getClipPart(clip, header->scalarTracksOffset, header->totalSizeInBytes) == nullptr)
+				return false;
+
+			// The static and default poses hold one transform of 12 floats per bone
+			if (header->numBones != static_cast<int>(tracks->get_num_tracks()))
+				return false;
+			const int64_t poseSizeInBytes = static_cast<int64_t>(header->numBones) * 12 * sizeof(float);
+			const int poseOffsets[] = { header->staticPoseOffset, header->defaultPoseOffset };
+			for (int poseOffset : poseOffsets)
+			{
+				if (poseOffset != 0 && (poseOffset < static_cast<int>(sizeof(CompressedClipHeader)) || (poseOffset & 15) != 0 || poseOffset + poseSizeInBytes > header->totalSizeInBytes))
+					return false;
+			}
+
+			outEntry.flags       = kArchiveEntryFlagCompressedClip;
+			outEntry.sizeInBytes = static_cast<uint32_t>(header->totalSizeInBytes);
+		}
+		else
+		{
+			if (tracks->is_valid(false).any() || tracks->get_size() > maxSizeInBytes)
+				return false;
+			outEntry.sizeInBytes = tracks->get_size();
+		}
+
+		outEntry.durationInSeconds = tracks->get_duration();
+		outEntry.numTracks         = tracks->get_num_tracks();
+		return true;
+	}
+
+	uint64_t alignTo16(uint64_t offset)
+	{
+		return (offset + 15) & ~static_cast<uint64_t>(15);
+	}
+
+	struct ClipArchive
+	{
+		const uint8_t*      data;
+		size_t              size;
+		const ArchiveEntry* entries;
+		uint32_t            numEntries;
+#if defined(_WIN32)
+		HANDLE              file;
+		HANDLE              mapping;
+#endif
+	};
+
+	bool mapFile(const char* path, ClipArchive& archive)
+	{
+#if defined(_WIN32)
+		archive.file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (archive.file == INVALID_HANDLE_VALUE)
+			return false;
+
+		LARGE_INTEGER fileSize;
+		archive.mapping = nullptr;
+		if (GetFileSizeEx(archive.file, &fileSize) && fileSize.QuadPart > 0)
+			archive.mapping = CreateFileMappingA(archive.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (archive.mapping == nullptr)
+		{
+			CloseHandle(archive.file);
+			return false;
+		}
+
+		archive.data = static_cast<const uint8_t*>(MapViewOfFile(archive.mapping, FILE_MAP_READ, 0, 0, 0));
+		if (archive.data == nullptr)
+		{
+			CloseHandle(archive.mapping);
+			CloseHandle(archive.file);
+			return false;
+		}
+		archive.size = static_cast<size_t>(fileSize.QuadPart);
+		return true;
+#else
+		const int fd = open(path, O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0)
+		{
+			close(fd);
+			return false;
+		}
+
+		void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+		// The mapping keeps its own reference to the file
+		close(fd);
+		if (data == MAP_FAILED)
+			return false;
+
+		archive.data = static_cast<const uint8_t*>(data);
+		archive.size = static_cast<size_t>(fileStat.st_size);
+		return true;
+#endif
+	}
+
+	void unmapFile(ClipArchive& archive)
+	{
+#if defined(_WIN32)
+		UnmapViewOfFile(archive.data);
+		CloseHandle(archive.mapping);
+		CloseHandle(archive.file);
+#else
+		munmap(const_cast<uint8_t*>(archive.data), archive.size);
+#endif
+	}
+
+	// Rejects truncated, foreign, or corrupted files up front. Every entry must point past the entry table and hold a clip whose headers
+	// describe the same size and kind, so that lookups and the samplers reading those headers stay within the mapping.
+	bool validateArchive(const ClipArchive& archive)
+	{
+		if (archive.size < sizeof(ArchiveHeader))
+			return false;
+
+		const ArchiveHeader* header = reinterpret_cast<const ArchiveHeader*>(archive.data);
+		if (header->magic != kArchiveMagic || header->version != kArchiveVersion)
+			return false;
+		if (header->numEntries > (archive.size - sizeof(ArchiveHeader)) / sizeof(ArchiveEntry))
+			return false;
+
+		const uint64_t entriesEnd = sizeof(ArchiveHeader) + static_cast<uint64_t>(header->numEntries) * sizeof(ArchiveEntry);
+		const ArchiveEntry* entries = reinterpret_cast<const ArchiveEntry*>(archive.data + sizeof(ArchiveHeader));
+		for (uint32_t i = 0; i < header->numEntries; i++)
+		{
+			const ArchiveEntry& entry = entries[i];
+			if ((entry.offset & 15) != 0 || entry.offset < entriesEnd || entry.offset > archive.size || entry.sizeInBytes > archive.size - entry.offset)
+				return false;
+			// Lookups binary search by name hash
+			if (i > 0 && entries[i - 1].nameHash > entry.nameHash)
+				return false;
+
+			ArchiveEntry described;
+			if (!describeClip(archive.data + entry.offset, entry.sizeInBytes, described))
+				return false;
+			if (described.sizeInBytes != entry.sizeInBytes || described.flags != entry.flags)
+				return false;
+		}
+		return true;
+	}
+}
+
+ACL_UNITY_API int buildClipArchive(const char* path, const unsigned long long* nameHashes, const void* const* compressedClips, int numClips)
+{
+	if (numClips < 0)
+		return 0;
+
+	std::vector<uint32_t> order(static_cast<size_t>(numClips));
+	for (int i = 0; i < numClips; i++)
+		order[i] = static_cast<uint32_t>(i);
+	std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return nameHashes[a] < nameHashes[b]; });
+
+	std::vector<ArchiveEntry> entries(static_cast<size_t>(numClips));
+	uint64_t offset = sizeof(ArchiveHeader) + entries.size() * sizeof(ArchiveEntry);
+	for (size_t i = 0; i < entries.size(); i++)
+	{
+		const uint32_t clipIndex = order[i];
+		if (i > 0 && nameHashes[clipIndex] == entries[i - 1].nameHash)
+			return 0;
+
+		ArchiveEntry& entry = entries[i];
+		if (!describeClip(compressedClips[clipIndex], UINT32_MAX, entry))
+			return 0;
+		entry.nameHash = nameHashes[clipIndex];
+		entry.offset   = alignTo16(offset);
+		offset         = entry.offset + entry.sizeInBytes;
+	}
+
+	std::FILE* file = std::fopen(path, "wb");
+	if (file == nullptr)
+		return 0;
+
+	ArchiveHeader header;
+	header.magic      = kArchiveMagic;
+	header.version    = kArchiveVersion;
+	header.numEntries = static_cast<uint32_t>(numClips);
+	header.reserved   = 0;
+
+	bool succeeded = std::fwrite(&header, sizeof(header), 1, file) == 1;
+	if (succeeded && !entries.empty())
+		succeeded = std::fwrite(entries.data(), sizeof(ArchiveEntry), entries.size(), file) == entries.size();
+
+	static const uint8_t padding[16] = {};
+	uint64_t position = sizeof(ArchiveHeader) + entries.size() * sizeof(ArchiveEntry);
+	for (size_t i = 0; succeeded && i < entries.size(); i++)
+	{
+		const ArchiveEntry& entry = entries[i];
+		const size_t paddingSize = static_cast<size_t>(entry.offset - position);
+		if (paddingSize > 0)
+			succeeded = std::fwrite(padding, 1, paddingSize, file) == paddingSize;
+		if (succeeded)
+			succeeded = std::fwrite(compressedClips[order[i]], 1, entry.sizeInBytes, file) == entry.sizeInBytes;
+		position = entry.offset + entry.sizeInBytes;
+	}
+
+	succeeded &= std::fclose(file) == 0;
+	if (!succeeded)
+		std::remove(path);
+	return succeeded ? 1 : 0;
+}
+
+ACL_UNITY_API void* openClipArchive(const char* path)
+{
+	ClipArchive* archive = new ClipArchive();
+	if (!mapFile(path, *archive))
+	{
+		delete archive;
+		return nullptr;
+	}
+
+	if (!validateArchive(*archive))
+	{
+		unmapFile(*archive);
+		delete archive;
+		return nullptr;
+	}
+
+	archive->numEntries = reinterpret_cast<const ArchiveHeader*>(archive->data)->numEntries;
+	archive->entries    = reinterpret_cast<const ArchiveEntry*>(archive->data + sizeof(ArchiveHeader));
+	return archive;
+}
+
+ACL_UNITY_API int getClipArchiveCount(const void* archive)
+{
+	return static_cast<int>(static_cast<const ClipArchive*>(archive)->numEntries);
+}
+
+ACL_UNITY_API int findClipInArchive(const void* archive, unsigned long long nameHash)
+{
+	const ClipArchive* clipArchive = static_cast<const ClipArchive*>(archive);
+	const ArchiveEntry* begin = clipArchive->entries;
+	const ArchiveEntry* end = begin + clipArchive->numEntries;
+	const ArchiveEntry* found = std::lower_bound(begin, end, nameHash, [](const ArchiveEntry& entry, unsigned long long hash) { return entry.nameHash < hash; });
+	if (found == end || found->nameHash != nameHash)
+		return -1;
+	return static_cast<int>(found - begin);
+}
+
+ACL_UNITY_API const void* getClipFromArchive(const void*         archive,
+											 int                 clipIndex,
+											 unsigned long long* outNameHash,
+											 float*              outDurationInSeconds,
+											 int*                outNumTracks,
+											 int*                outSizeInBytes,
+											 int*                outIsCompressedClip)
+{
+	const ClipArchive* clipArchive = static_cast<const ClipArchive*>(archive);
+	if (clipIndex < 0 || static_cast<uint32_t>(clipIndex) >= clipArchive->numEntries)
+		return nullptr;
+
+	const ArchiveEntry& entry = clipArchive->entries[clipIndex];
+	if (outNameHash != nullptr)
+		*outNameHash = entry.nameHash;
+	if (outDurationInSeconds != nullptr)
+		*outDurationInSeconds = entry.durationInSeconds;
+	if (outNumTracks != nullptr)
+		*outNumTracks = static_cast<int>(entry.numTracks);
+	if (outSizeInBytes != nullptr)
+		*outSizeInBytes = static_cast<int>(entry.sizeInBytes);
+	if (outIsCompressedClip != nullptr)
+		*outIsCompressedClip = (entry.flags & kArchiveEntryFlagCompressedClip) != 0 ? 1 : 0;
+	return clipArchive->data + entry.offset;
+}
+
+ACL_UNITY_API void closeClipArchive(void* archive)
+{
+	ClipArchive* clipArchive = static_cast<ClipArchive*>(archive);
+	unmapFile(*clipArchive);
+	delete clipArchive;
+}
@@ -1,4 +1,5 @@
 #include "compression.h"
+#include "decompression.h"
 
 // Include bug: transform_error_metric depends on core/track_types but does not include it
 #include "acl/core/track_types.h"
@@ -6,8 +7,26 @@
 #include "acl/compression/compress.h"
 #include "acl/core/ansi_allocator.h"
 #include "acl/compression/pre_process.h"
+#include "acl/compression/track_error.h"
+#include "acl/core/impl/compressed_headers.h"
+
+#include "decompression_settings.h"
+#include "simd_utilities.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 using namespace acl;
+using AclUnity::TransformDecompressionContext;
+using AclUnity::FloatDecompressionContext;
 
 namespace
 {
@@ -22,6 +41,191 @@ namespace
 			const rtm::vector4f scaleStretch = rtm::vector_set_w(child.scale, scale * rtm::vector_get_w(child.scale));
 			return rtm::qvv_set(rotation, translation, scaleStretch);
 		}
+
+		// Equivalent to qvv_normalize(qvvsMul(child, parent)) for four independent transforms at once.
+		// The inputs are transposed so that every step is a full-width SIMD operation.
+		RTM_FORCE_INLINE void RTM_SIMD_CALL qvvsMulNormalize4(const rtm::qvvf* const children[4], const rtm::qvvf* const parents[4], rtm::qvvf* const outputs[4])
+		{
+			using AclUnity::transpose4x4;
+
+			rtm::vector4f cqx, cqy, cqz, cqw;
+			transpose4x4(rtm::quat_to_vector(children[0]->rotation), rtm::quat_to_vector(children[1]->rotation), rtm::quat_to_vector(children[2]->rotation), rtm::quat_to_vector(children[3]->rotation), cqx, cqy, cqz, cqw);
+			rtm::vector4f ctx, cty, ctz, ctw;
+			transpose4x4(children[0]->translation, children[1]->translation, children[2]->translation, children[3]->translation, ctx, cty, ctz, ctw);
+			rtm::vector4f csx, csy, csz, csw;
+			transpose4x4(children[0]->scale, children[1]->scale, children[2]->scale, children[3]->scale, csx, csy, csz, csw);
+
+			rtm::vector4f pqx, pqy, pqz, pqw;
+			transpose4x4(rtm::quat_to_vector(parents[0]->rotation), rtm::quat_to_vector(parents[1]->rotation), rtm::quat_to_vector(parents[2]->rotation), rtm::quat_to_vector(parents[3]->rotation), pqx, pqy, pqz, pqw);
+			rtm::vector4f ptx, pty, ptz, ptw;
+			transpose4x4(parents[0]->translation, parents[1]->translation, parents[2]->translation, parents[3]->translation, ptx, pty, ptz, ptw);
+			rtm::vector4f psx, psy, psz, psw;
+			transpose4x4(parents[0]->scale, parents[1]->scale, parents[2]->scale, parents[3]->scale, psx, psy, psz, psw);
+
+			// rotation = quat_mul(child, parent), which applies the child rotation first
+			const rtm::vector4f qx = rtm::vector_sub(rtm::vector_mul_add(pqw, cqx, rtm::vector_mul_add(pqx, cqw, rtm::vector_mul(pqy, cqz))), rtm::vector_mul(pqz, cqy));
+			const rtm::vector4f qy = rtm::vector_add(rtm::vector_sub(rtm::vector_mul_add(pqw, cqy, rtm::vector_mul(pqy, cqw)), rtm::vector_mul(pqx, cqz)), rtm::vector_mul(pqz, cqx));
+			const rtm::vector4f qz = rtm::vector_sub(rtm::vector_mul_add(pqw, cqz, rtm::vector_mul_add(pqx, cqy, rtm::vector_mul(pqz, cqw))), rtm::vector_mul(pqy, cqx));
+			const rtm::vector4f qw = rtm::vector_sub(rtm::vector_mul(pqw, cqw), rtm::vector_mul_add(pqx, cqx, rtm::vector_mul_add(pqy, cqy, rtm::vector_mul(pqz, cqz))));
+
+			const rtm::vector4f lengthSquared = rtm::vector_mul_add(qx, qx, rtm::vector_mul_add(qy, qy, rtm::vector_mul_add(qz, qz, rtm::vector_mul(qw, qw))));
+			const rtm::vector4f inverseLength = rtm::vector_div(rtm::vector_set(1.f), rtm::vector_sqrt(lengthSquared));
+
+			// translation = rotate(child.translation * parent.scale * parent.uniformScale, parent.rotation) + parent.translation
+			const rtm::vector4f vx = rtm::vector_mul(ctx, rtm::vector_mul(psx, psw));
+			const rtm::vector4f vy = rtm::vector_mul(cty, rtm::vector_mul(psy, psw));
+			const rtm::vector4f vz = rtm::vector_mul(ctz, rtm::vector_mul(psz, psw));
+
+			const rtm::vector4f two = rtm::vector_set(2.f);
+			const rtm::vector4f tx = rtm::vector_mul(two, rtm::vector_sub(rtm::vector_mul(pqy, vz), rtm::vector_mul(pqz, vy)));
+			const rtm::vector4f ty = rtm::vector_mul(two, rtm::vector_sub(rtm::vector_mul(pqz, vx), rtm::vector_mul(pqx, vz)));
+			const rtm::vector4f tz = rtm::vector_mul(two, rtm::vector_sub(rtm::vector_mul(pqx, vy), rtm::vector_mul(pqy, vx)));
+
+			const rtm::vector4f rx = rtm::vector_add(rtm::vector_mul_add(pqw, tx, vx), rtm::vector_add(rtm::vector_sub(rtm::vector_mul(pqy, tz), rtm::vector_mul(pqz, ty)), ptx));
+			const rtm::vector4f ry = rtm::vector_add(rtm::vector_mul_add(pqw, ty, vy), rtm::vector_add(rtm::vector_sub(rtm::vector_mul(pqz, tx), rtm::vector_mul(pqx, tz)), pty));
+			const rtm::vector4f rz = rtm::vector_add(rtm::vector_mul_add(pqw, tz, vz), rtm::vector_add(rtm::vector_sub(rtm::vector_mul(pqx, ty), rtm::vector_mul(pqy, tx)), ptz));
+
+			rtm::vector4f rotation[4];
+			transpose4x4(rtm::vector_mul(qx, inverseLength), rtm::vector_mul(qy, inverseLength), rtm::vector_mul(qz, inverseLength), rtm::vector_mul(qw, inverseLength), rotation[0], rotation[1], rotation[2], rotation[3]);
+			rtm::vector4f translation[4];
+			transpose4x4(rx, ry, rz, rtm::vector_zero(), translation[0], translation[1], translation[2], translation[3]);
+			rtm::vector4f scale[4];
+			transpose4x4(csx, csy, csz, rtm::vector_mul(csw, psw), scale[0], scale[1], scale[2], scale[3]);
+
+			for (int i = 0; i < 4; i++)
+				*outputs[i] = rtm::qvv_set(rtm::vector_to_quat(rotation[i]), translation[i], scale[i]);
+		}
+
+		// Returns true if some depth level could hold four or more of the dirty transforms, without computing any depth.
+		// A transform whose parent is the dirty transform just before it is deeper than that transform, so two transforms
+		// at the same depth always have a break in that chain between them. Four transforms at the same depth therefore need
+		// at least three breaks, which ACL's bone chains never have.
+		bool mayHaveWideLevel(const uint32_t* dirtyTransformIndices, uint32_t numDirtyTransforms, const uint32_t* parentTransformIndices)
+		{
+			uint32_t numBreaks = 0;
+			for (uint32_t i = 1; i < numDirtyTransforms; i++)
+			{
+				if (parentTransformIndices[dirtyTransformIndices[i]] != dirtyTransformIndices[i - 1])
+					numBreaks++;
+			}
+			return numBreaks >= 3;
+		}
+
+		// Groups dirty transforms by their depth in the hierarchy. Transforms at the same depth never depend on each other,
+		// so each level can be composed several transforms at a time. Holds only the scratch memory of a single call.
+		class TransformDepthLevels
+		{
+		private:
+			static constexpr uint32_t kUnknownDepth  = 0xFFFFFFFFu;
+			static constexpr uint32_t kVisitingDepth = 0xFFFFFFFEu;
+
+			std::vector<uint32_t> m_depths;
+			std::vector<uint32_t> m_levelOffsets;
+			std::vector<uint32_t> m_sortedIndices;
+			std::vector<uint32_t> m_chain;
+
+			uint32_t& depthOf(uint32_t transformIndex)
+			{
+				if (transformIndex >= m_depths.size())
+					m_depths.resize(transformIndex + 1, static_cast<uint32_t>(kUnknownDepth));
+				return m_depths[transformIndex];
+			}
+
+			// Walks up to the nearest ancestor with a known depth, then assigns depths back down the chain.
+			// A malformed hierarchy with a cycle treats the transform at which the cycle closes as a root.
+			uint32_t getDepth(uint32_t transformIndex, const uint32_t* parentTransformIndices)
+			{
+				m_chain.clear();
+				uint32_t depth = 0;
+				for (uint32_t index = transformIndex; index != k_invalid_track_index; index = parentTransformIndices[index])
+				{
+					uint32_t& known = depthOf(index);
+					if (known == kVisitingDepth)
+						break;
+					if (known != kUnknownDepth)
+					{
+						depth = known + 1;
+						break;
+					}
+					known = kVisitingDepth;
+					m_chain.push_back(index);
+				}
+
+				for (size_t i = m_chain.size(); i-- > 0; depth++)
+					m_depths[m_chain[i]] = depth;
+				return m_depths[transformIndex];
+			}
+
+		public:
+			// Counts the dirty transforms at each depth and returns the number of transforms in the widest level
+			uint32_t countLevels(const uint32_t* dirtyTransformIndices, uint32_t numDirtyTransforms, const uint32_t* parentTransformIndices)
+			{
+				uint32_t numLevels = 0;
+				for (uint32_t i = 0; i < numDirtyTransforms; i++)
+					numLevels = std::max(numLevels, getDepth(dirtyTransformIndices[i], parentTransformIndices) + 1);
+
+				m_levelOffsets.assign(numLevels + 1, 0);
+				for (uint32_t i = 0; i < numDirtyTransforms; i++)
+					m_levelOffsets[m_depths[dirtyTransformIndices[i]] + 1]++;
+				return numLevels == 0 ? 0 : *std::max_element(m_levelOffsets.begin() + 1, m_levelOffsets.end());
+			}
+
+			// Sorts the transforms counted by countLevels and returns the number of levels.
+			// Level i spans getSortedIndices()[getLevelOffsets()[i] .. getLevelOffsets()[i + 1]).
+			uint32_t sort(const uint32_t* dirtyTransformIndices, uint32_t numDirtyTransforms)
+			{
+				const uint32_t numLevels = static_cast<uint32_t>(m_levelOffsets.size()) - 1;
+				for (uint32_t level = 0; level < numLevels; level++)
+					m_levelOffsets[level + 1] += m_levelOffsets[level];
+
+				// Counting sort keeps ACL's parent-first order within each level
+				m_sortedIndices.resize(numDirtyTransforms);
+				std::vector<uint32_t>::iterator cursor = m_levelOffsets.begin();
+				for (uint32_t i = 0; i < numDirtyTransforms; i++)
+				{
+					const uint32_t transformIndex = dirtyTransformIndices[i];
+					m_sortedIndices[cursor[m_depths[transformIndex]]++] = transformIndex;
+				}
+
+				// The fill above advanced each offset to the end of its level, so shift them back to the level starts
+				for (uint32_t level = numLevels; level > 0; level--)
+					m_levelOffsets[level] = m_levelOffsets[level - 1];
+				m_levelOffsets[0] = 0;
+				return numLevels;
+			}
+
+			const uint32_t* getLevelOffsets() const { return m_levelOffsets.data(); }
+			const uint32_t* getSortedIndices() const { return m_sortedIndices.data(); }
+		};
+
+		// Measures how far the shell points drift between the raw and lossy object space transforms.
+		// Because the transforms carry scale, all three axes must be measured.
+		RTM_FORCE_INLINE rtm::scalarf RTM_SIMD_CALL calculateShellError(const rtm::qvvf& raw_transform_,
+																		 const rtm::qvvf& lossy_transform_,
+																		 rtm::vector4f_arg0 vtx0,
+																		 rtm::vector4f_arg1 vtx1,
+																		 rtm::vector4f_arg2 vtx2)
+		{
+			const float rtScale = rtm::vector_get_w(raw_transform_.scale);
+			const rtm::qvvf rtPatched = rtm::qvv_set(raw_transform_.rotation, raw_transform_.translation, rtm::vector_mul(raw_transform_.scale, rtScale));
+
+			const float ltScale = rtm::vector_get_w(lossy_transform_.scale);
+			const rtm::qvvf ltPatched = rtm::qvv_set(lossy_transform_.rotation, lossy_transform_.translation, rtm::vector_mul(lossy_transform_.scale, ltScale));
+
+			const rtm::vector4f raw_vtx0 = rtm::qvv_mul_point3(vtx0, rtPatched);
+			const rtm::vector4f raw_vtx1 = rtm::qvv_mul_point3(vtx1, rtPatched);
+			const rtm::vector4f raw_vtx2 = rtm::qvv_mul_point3(vtx2, rtPatched);
+
+			const rtm::vector4f lossy_vtx0 = rtm::qvv_mul_point3(vtx0, ltPatched);
+			const rtm::vector4f lossy_vtx1 = rtm::qvv_mul_point3(vtx1, ltPatched);
+			const rtm::vector4f lossy_vtx2 = rtm::qvv_mul_point3(vtx2, ltPatched);
+
+			const rtm::scalarf vtx0_error = rtm::vector_distance3(raw_vtx0, lossy_vtx0);
+			const rtm::scalarf vtx1_error = rtm::vector_distance3(raw_vtx1, lossy_vtx1);
+			const rtm::scalarf vtx2_error = rtm::vector_distance3(raw_vtx2, lossy_vtx2);
+
+			return rtm::scalar_max(rtm::scalar_max(vtx0_error, vtx1_error), vtx2_error);
+		}
 	}
 	
 	class QvvsNoScaleTransformErrorMetric : public qvvf_transform_error_metric
@@ -31,24 +235,66 @@ namespace
 
 		virtual RTM_DISABLE_SECURITY_COOKIE_CHECK void local_to_object_space(const local_to_object_space_args& args, void* out_object_transforms) const override
 		{
-			const uint32_t* dirty_transform_indices = args.dirty_transform_indices;
 			const uint32_t* parent_transform_indices = args.parent_transform_indices;
 			const rtm::qvvf* local_transforms_ = static_cast<const rtm::qvvf*>(args.local_transforms);
 			rtm::qvvf* out_object_transforms_ = static_cast<rtm::qvvf*>(out_object_transforms);
 
-			const uint32_t num_dirty_transforms = args.num_dirty_transforms;
-			for (uint32_t dirty_transform_index = 0; dirty_transform_index < num_dirty_transforms; ++dirty_transform_index)
+			// Composing four transforms at a time only pays off once a level holds that many, so bone chains take the scalar path
+			TransformDepthLevels depthLevels;
+			if (!mayHaveWideLevel(args.dirty_transform_indices, args.num_dirty_transforms, parent_transform_indices) ||
+				depthLevels.countLevels(args.dirty_transform_indices, args.num_dirty_transforms, parent_transform_indices) < 4)
 			{
-				const uint32_t transform_index = dirty_transform_indices[dirty_transform_index];
-				const uint32_t parent_transform_index = parent_transform_indices[transform_index];
+				for (uint32_t dirty_index = 0; dirty_index < args.num_dirty_transforms; ++dirty_index)
+				{
+					const uint32_t transform_index = args.dirty_transform_indices[dirty_index];
+					const uint32_t parent_transform_index = parent_transform_indices[transform_index];
+					if (parent_transform_index == k_invalid_track_index)
+						out_object_transforms_[transform_index] = local_transforms_[transform_index];
+					else
+						out_object_transforms_[transform_index] = rtm::qvv_normalize(qvvsMul(local_transforms_[transform_index], out_object_transforms_[parent_transform_index]));
+				}
+				return;
+			}
 
-				rtm::qvvf obj_transform;
-				if (parent_transform_index == k_invalid_track_index)
-					obj_transform = local_transforms_[transform_index];	// Just copy the root as-is, it has no parent and thus local and object space transforms are equal
-				else
-					obj_transform = rtm::qvv_normalize(qvvsMul(local_transforms_[transform_index], out_object_transforms_[parent_transform_index]));
+			const uint32_t num_levels = depthLevels.sort(args.dirty_transform_indices, args.num_dirty_transforms);
+			const uint32_t* level_offsets = depthLevels.getLevelOffsets();
+			const uint32_t* sorted_transform_indices = depthLevels.getSortedIndices();
+
+			// Just copy the roots as-is, they have no parent and thus local and object space transforms are equal
+			if (num_levels > 0)
+			{
+				for (uint32_t sorted_index = level_offsets[0]; sorted_index < level_offsets[1]; ++sorted_index)
+				{
+					const uint32_t transform_index = sorted_transform_indices[sorted_index];
+					out_object_transforms_[transform_index] = local_transforms_[transform_index];
+				}
+			}
+
+			for (uint32_t level = 1; level < num_levels; ++level)
+			{
+				uint32_t sorted_index = level_offsets[level];
+				const uint32_t level_end = level_offsets[level + 1];
+				for (; sorted_index + 4 <= level_end; sorted_index += 4)
+				{
+					const rtm::qvvf* children[4];
+					const rtm::qvvf* parents[4];
+					rtm::qvvf* outputs[4];
+					for (uint32_t lane = 0; lane < 4; ++lane)
+					{
+						const uint32_t transform_index = sorted_transform_indices[sorted_index + lane];
+						children[lane] = &local_transforms_[transform_index];
+						parents[lane]  = &out_object_transforms_[parent_transform_indices[transform_index]];
+						outputs[lane]  = &out_object_transforms_[transform_index];
+					}
+					qvvsMulNormalize4(children, parents, outputs);
+				}
 
-				out_object_transforms_[transform_index] = obj_transform;
+				for (; sorted_index < level_end; ++sorted_index)
+				{
+					const uint32_t transform_index = sorted_transform_indices[sorted_index];
+					const uint32_t parent_transform_index = parent_transform_indices[transform_index];
+					out_object_transforms_[transform_index] = rtm::qvv_normalize(qvvsMul(local_transforms_[transform_index], out_object_transforms_[parent_transform_index]));
+				}
 			}
 		}
 	};
@@ -75,10 +321,11 @@ namespace
 
 			if (args.is_lossy)
 			{
+				const float* sampleScales = m_sampledScales + args.sample_index * m_numTransforms;
 				for (uint32_t dirtyTransformIndex = 0; dirtyTransformIndex < numDirtyTransforms; ++dirtyTransformIndex)
 				{
 					const uint32_t transformIndex = dirtyTransformIndices[dirtyTransformIndex];
-					const float scale = m_sampledScales[args.sample_index * m_numTransforms + transformIndex];
+					const float scale = sampleScales[transformIndex];
 
 					outTransforms[transformIndex] = qvvfTransforms[transformIndex];
 					outTransforms[transformIndex].scale = rtm::vector_set_w(qvvfTransforms[transformIndex].scale, scale);
@@ -110,133 +357,1709 @@ namespace
 			const rtm::qvvf& raw_transform_ = *static_cast<const rtm::qvvf*>(args.transform0);
 			const rtm::qvvf& lossy_transform_ = *static_cast<const rtm::qvvf*>(args.transform1);
 
-			const float rtScale = rtm::vector_get_w(raw_transform_.scale);
-			const rtm::qvvf rtPatched = rtm::qvv_set(raw_transform_.rotation, raw_transform_.translation, rtm::vector_mul(raw_transform_.scale, rtScale));
+			return calculateShellError(raw_transform_, lossy_transform_, args.shell_point_x, args.shell_point_y, args.shell_point_z);
+		}
 
-			const float ltScale = rtm::vector_get_w(lossy_transform_.scale);
-			const rtm::qvvf ltPatched = rtm::qvv_set(lossy_transform_.rotation, lossy_transform_.translation, rtm::vector_mul(lossy_transform_.scale, ltScale));
+		virtual RTM_DISABLE_SECURITY_COOKIE_CHECK rtm::scalarf RTM_SIMD_CALL calculate_error_no_scale(const calculate_error_args& args) const override
+		{
+			return calculate_error(args);
+		}
+	};
 
-			// Note that because we have scale, we must measure all three axes
-			const rtm::vector4f vtx0 = args.shell_point_x;
-			const rtm::vector4f vtx1 = args.shell_point_y;
-			const rtm::vector4f vtx2 = args.shell_point_z;
+	// Routes allocations to the caller's callbacks when provided, otherwise to the system allocator
+	class CompressionAllocator final : public iallocator
+	{
+	private:
+		const AllocatorCallbacks* m_callbacks;
+		ansi_allocator            m_fallback;
 
-			const rtm::vector4f raw_vtx0 = rtm::qvv_mul_point3(vtx0, rtPatched);
-			const rtm::vector4f raw_vtx1 = rtm::qvv_mul_point3(vtx1, rtPatched);
-			const rtm::vector4f raw_vtx2 = rtm::qvv_mul_point3(vtx2, rtPatched);
+	public:
+		explicit CompressionAllocator(const AllocatorCallbacks* callbacks) : m_callbacks(callbacks) {}
 
-			const rtm::vector4f lossy_vtx0 = rtm::qvv_mul_point3(vtx0, ltPatched);
-			const rtm::vector4f lossy_vtx1 = rtm::qvv_mul_point3(vtx1, ltPatched);
-			const rtm::vector4f lossy_vtx2 = rtm::qvv_mul_point3(vtx2, ltPatched);
+		virtual void* allocate(size_t size, size_t alignment) override
+		{
+			if (m_callbacks == nullptr)
+				return m_fallback.allocate(size, alignment);
+			return m_callbacks->allocate(m_callbacks->userData, size, alignment);
+		}
 
-			const rtm::scalarf vtx0_error = rtm::vector_distance3(raw_vtx0, lossy_vtx0);
-			const rtm::scalarf vtx1_error = rtm::vector_distance3(raw_vtx1, lossy_vtx1);
-			const rtm::scalarf vtx2_error = rtm::vector_distance3(raw_vtx2, lossy_vtx2);
+		virtual void deallocate(void* ptr, size_t size) override
+		{
+			if (ptr == nullptr)
+				return;
+			if (m_callbacks == nullptr)
+				m_fallback.deallocate(ptr, size);
+			else
+				m_callbacks->deallocate(m_callbacks->userData, ptr, size);
+		}
+	};
 
-			return rtm::scalar_max(rtm::scalar_max(vtx0_error, vtx1_error), vtx2_error);
+	const AllocatorCallbacks* getAllocatorCallbacks(const CompressionOptions* options)
+	{
+		return options == nullptr ? nullptr : options->allocator;
+	}
+
+	// Locates the samples of each bone within raw clip data regardless of whether it is stored bone-major or frame-major
+	struct ClipDataView
+	{
+		const rtm::qvvf* data;
+		size_t           boneStride;
+		size_t           sampleStride;
+
+		size_t indexOf(int boneIndex, int sampleIndex) const { return boneIndex * boneStride + sampleIndex * sampleStride; }
+		const rtm::qvvf& get(int boneIndex, int sampleIndex) const { return data[indexOf(boneIndex, sampleIndex)]; }
+	};
+
+	ClipDataView makeClipDataView(const rtm::qvvf* data, short numBones, int numSamples, bool isFrameMajor)
+	{
+		ClipDataView view;
+		view.data         = data;
+		view.boneStride   = isFrameMajor ? 1 : static_cast<size_t>(numSamples);
+		view.sampleStride = isFrameMajor ? static_cast<size_t>(numBones) : 1;
+		return view;
+	}
+
+	// Converts SOA clip data into frame-major AOS, four transforms at a time
+	void transposeSoaClipData(const float* soaClipData, short numBones, int numSamples, rtm::qvvf* outFrameMajorData)
+	{
+		const size_t count = static_cast<size_t>(numBones) * static_cast<size_t>(numSamples);
+		const float* streams[11];
+		for (size_t i = 0; i < 11; i++)
+			streams[i] = soaClipData + i * count;
+
+		size_t index = 0;
+		for (; index + 4 <= count; index += 4)
+		{
+			rtm::vector4f r0, r1, r2, r3;
+			AclUnity::transpose4x4(rtm::vector_load(streams[0] + index), rtm::vector_load(streams[1] + index), rtm::vector_load(streams[2] + index), rtm::vector_load(streams[3] + index), r0, r1, r2, r3);
+			rtm::vector4f t0, t1, t2, t3;
+			AclUnity::transpose4x4(rtm::vector_load(streams[4] + index), rtm::vector_load(streams[5] + index), rtm::vector_load(streams[6] + index), rtm::vector_zero(), t0, t1, t2, t3);
+			rtm::vector4f s0, s1, s2, s3;
+			AclUnity::transpose4x4(rtm::vector_load(streams[7] + index), rtm::vector_load(streams[8] + index), rtm::vector_load(streams[9] + index), rtm::vector_load(streams[10] + index), s0, s1, s2, s3);
+
+			outFrameMajorData[index + 0] = rtm::qvv_set(rtm::vector_to_quat(r0), t0, s0);
+			outFrameMajorData[index + 1] = rtm::qvv_set(rtm::vector_to_quat(r1), t1, s1);
+			outFrameMajorData[index + 2] = rtm::qvv_set(rtm::vector_to_quat(r2), t2, s2);
+			outFrameMajorData[index + 3] = rtm::qvv_set(rtm::vector_to_quat(r3), t3, s3);
 		}
 
-		virtual RTM_DISABLE_SECURITY_COOKIE_CHECK rtm::scalarf RTM_SIMD_CALL calculate_error_no_scale(const calculate_error_args& args) const override
+		for (; index < count; index++)
 		{
-			return calculate_error(args);
+			const rtm::quatf rotation = rtm::quat_set(streams[0][index], streams[1][index], streams[2][index], streams[3][index]);
+			const rtm::vector4f translation = rtm::vector_set(streams[4][index], streams[5][index], streams[6][index], 0.f);
+			const rtm::vector4f scale = rtm::vector_set(streams[7][index], streams[8][index], streams[9][index], streams[10][index]);
+			outFrameMajorData[index] = rtm::qvv_set(rotation, translation, scale);
+		}
+	}
+
+	enum ClipDataLayout
+	{
+		kClipDataLayoutBoneMajor  = 0,
+		kClipDataLayoutFrameMajor = 1,
+		kClipDataLayoutSoa        = 2,
+	};
+
+	int getClipDataLayout(const CompressionOptions* options)
+	{
+		return options == nullptr ? kClipDataLayoutBoneMajor : options->clipDataLayout;
+	}
+
+	int getIdealSegmentSize(const CompressionOptions* options)
+	{
+		return options == nullptr ? 0 : options->idealSamplesPerSegment;
+	}
+
+	int getMaxSegmentSize(const CompressionOptions* options)
+	{
+		return options == nullptr ? 0 : options->maxSamplesPerSegment;
+	}
+
+	// Presents raw clip data in any supported layout as a ClipDataView.
+	// SOA data is transposed into scratch memory owned by this object, since ACL tracks require AOS samples.
+	class RawClipData
+	{
+	private:
+		iallocator&  m_allocator;
+		rtm::qvvf*   m_scratch;
+		size_t       m_scratchSize;
+		ClipDataView m_view;
+
+	public:
+		RawClipData(iallocator& allocator, const float* clipData, short numBones, int numSamples, int layout) : m_allocator(allocator), m_scratch(nullptr), m_scratchSize(0)
+		{
+			if (layout == kClipDataLayoutSoa)
+			{
+				m_scratchSize = static_cast<size_t>(numBones) * static_cast<size_t>(numSamples) * sizeof(rtm::qvvf);
+				m_scratch = static_cast<rtm::qvvf*>(allocator.allocate(m_scratchSize, alignof(rtm::qvvf)));
+				transposeSoaClipData(clipData, numBones, numSamples, m_scratch);
+				m_view = makeClipDataView(m_scratch, numBones, numSamples, true);
+			}
+			else
+				m_view = makeClipDataView(reinterpret_cast<const rtm::qvvf*>(clipData), numBones, numSamples, layout == kClipDataLayoutFrameMajor);
 		}
+
+		~RawClipData()
+		{
+			if (m_scratch != nullptr)
+				m_allocator.deallocate(m_scratch, m_scratchSize);
+		}
+
+		const ClipDataView& getView() const { return m_view; }
+
+		// The private scratch memory behind the view which may be pre-processed in place, or nullptr when the view references the caller's data
+		rtm::qvvf* getScratch() const { return m_scratch; }
 	};
-}
 
-ACL_UNITY_API void* compressSkeletonClip(const signed short* parentIndices, 
-										 signed short        numBones, 
-										 signed short        compressionLevel, 
-										 const float*        aosClipData, 
-										 int                 numSamples, 
-										 float               sampleRate, 
-										 float               maxDistanceError, 
-										 float               sampledErrorDistanceFromBone, 
-										 int*                outCompressedSizeInBytes,
-										 float*              sampledScales)
-{
-	ansi_allocator allocator;
+	uint32_t resolveParentIndex(const signed short* parentIndices, short boneIndex)
+	{
+		short parentIndex = static_cast<short>(parentIndices[boneIndex]);
+		if (parentIndex == boneIndex || parentIndex == -1)
+			return k_invalid_track_index;
+		return static_cast<uint32_t>(parentIndex);
+	}
 
-	track_array_qvvf      trackArray(allocator, static_cast<uint32_t>(numBones));
-	// Todo: Upgrade to C++20 to use std::bit_cast instead.
-	auto*                 clipData = reinterpret_cast<const rtm::qvvf*>(aosClipData);
-	track_desc_transformf trackDesc;
-	trackDesc.precision                      = maxDistanceError;
-	trackDesc.shell_distance                 = sampledErrorDistanceFromBone;
-	for (short i = 0; i < numBones; i++)
+	// Rotation error at a bone displaces every vertex skinned to its descendants, so the shell of a bone must
+	// reach the furthest skinned vertex anywhere in its subtree. Chain lengths use the longest local translation
+	// in the clip to stay conservative for stretching bones.
+	void computeShellDistances(const signed short* parentIndices,
+							   signed short        numBones,
+							   const ClipDataView& clip,
+							   int                 numSamples,
+							   const float*        boneRadii,
+							   float               fallbackDistance,
+							   float*              outShellDistances)
 	{
-		trackDesc.output_index = static_cast<uint32_t>(i);
-		short parentIndex      = static_cast<short>(parentIndices[i]);
-		if (parentIndex == i || parentIndex == -1)
+		std::vector<float> boneLengths(static_cast<size_t>(numBones), 0.f);
+		for (short i = 0; i < numBones; i++)
 		{
-			trackDesc.parent_index = k_invalid_track_index;
+			float maxLength = 0.f;
+			for (int s = 0; s < numSamples; s++)
+			{
+				const float length = rtm::vector_length3(clip.get(i, s).translation);
+				maxLength = std::max(maxLength, length);
+			}
+			boneLengths[i] = maxLength;
+			outShellDistances[i] = std::max(boneRadii[i], 0.f);
 		}
-		else
+
+		for (short i = 0; i < numBones; i++)
+		{
+			const float radius = boneRadii[i];
+			if (radius <= 0.f)
+				continue;
+
+			float chainLength = 0.f;
+			uint32_t child = static_cast<uint32_t>(i);
+			uint32_t parent = resolveParentIndex(parentIndices, i);
+			// The depth can never exceed the bone count unless the hierarchy contains a cycle
+			for (short depth = 0; parent != k_invalid_track_index && depth < numBones; depth++)
+			{
+				chainLength += boneLengths[child];
+				outShellDistances[parent] = std::max(outShellDistances[parent], chainLength + radius);
+				child = parent;
+				parent = resolveParentIndex(parentIndices, static_cast<short>(parent));
+			}
+		}
+
+		for (short i = 0; i < numBones; i++)
 		{
-			trackDesc.parent_index = static_cast<uint32_t>(parentIndex);
+			if (outShellDistances[i] <= 0.f)
+				outShellDistances[i] = fallbackDistance;
 		}
-		trackArray[i] = track_qvvf::make_copy(trackDesc, allocator, clipData + i * numSamples, static_cast<uint32_t>(numSamples), sampleRate);
 	}
 
-	auto compressionSettings  = get_default_compression_settings();
-	compressionSettings.level = static_cast<compression_level8>(compressionLevel);
+	void initializeShellDistances(const signed short*       parentIndices,
+								  signed short              numBones,
+								  const ClipDataView&       clip,
+								  int                       numSamples,
+								  float                     sampledErrorDistanceFromBone,
+								  const CompressionOptions* options,
+								  float*                    outShellDistances)
+	{
+		if (options != nullptr && options->boneRadii != nullptr)
+			computeShellDistances(parentIndices, numBones, clip, numSamples, options->boneRadii, sampledErrorDistanceFromBone, outShellDistances);
+		else
+			std::fill(outShellDistances, outShellDistances + numBones, sampledErrorDistanceFromBone);
+	}
 
-	QvvsNoScaleTransformErrorMetric errorMetricA;
-	QvvsTransformErrorMetric errorMetricB(sampledScales, numBones);
-	if (sampledScales == nullptr)
-		compressionSettings.error_metric = &errorMetricA;
-	else
-		compressionSettings.error_metric = &errorMetricB;
+	struct SkeletonClipSource
+	{
+		// Skeleton
+		const signed short*       parentIndices;
+		const float*              shellDistances;
+		const float*              defaultPose;
+		signed short              numBones;
 
-	pre_process_settings_t settings;
-	settings.error_metric = compressionSettings.error_metric;
-	pre_process_track_list(allocator, settings, trackArray);
+		// Raw samples
+		ClipDataView              clip;
+		rtm::qvvf*                mutableClipData;
+		const float*              sampledScales;
+		int                       numSamples;
+		float                     sampleRate;
 
-	compressed_tracks* outCompressedTracks = nullptr;
-	output_stats outputStats;
+		// Compression settings
+		float                     maxDistanceError;
+		signed short              compressionLevel;
+		int                       idealSegmentSize;
+		int                       maxSegmentSize;
+		bool                      enableDatabase;
+		float                     stripProportion;
+		float                     stripThreshold;
+		const AllocatorCallbacks* allocatorCallbacks;
+	};
 
-	compress_track_list(allocator, trackArray, compressionSettings, outCompressedTracks, outputStats);
-	*outCompressedSizeInBytes = outCompressedTracks->get_size();
-	
-	return outCompressedTracks;
-}
+	// Fills every field from the parameters and options. The raw samples are never pre-processed in place unless mutableClipData is set afterwards.
+	SkeletonClipSource makeSkeletonClipSource(const CompressionOptions* options,
+											  const signed short*       parentIndices,
+											  signed short              numBones,
+											  signed short              compressionLevel,
+											  const ClipDataView&       clip,
+											  int                       numSamples,
+											  float                     sampleRate,
+											  float                     maxDistanceError,
+											  const float*              shellDistances,
+											  const float*              sampledScales)
+	{
+		SkeletonClipSource source;
+		source.parentIndices      = parentIndices;
+		source.shellDistances     = shellDistances;
+		source.defaultPose        = options == nullptr ? nullptr : options->defaultPose;
+		source.numBones           = numBones;
+		source.clip               = clip;
+		source.mutableClipData    = nullptr;
+		source.sampledScales      = sampledScales;
+		source.numSamples         = numSamples;
+		source.sampleRate         = sampleRate;
+		source.maxDistanceError   = maxDistanceError;
+		source.compressionLevel   = compressionLevel;
+		source.idealSegmentSize   = getIdealSegmentSize(options);
+		source.maxSegmentSize     = getMaxSegmentSize(options);
+		source.enableDatabase     = options != nullptr && options->enableDatabaseSupport != 0;
+		source.stripProportion    = options == nullptr ? 0.f : options->keyframeStrippingProportion;
+		source.stripThreshold     = options == nullptr ? 0.f : options->keyframeStrippingThreshold;
+		source.allocatorCallbacks = getAllocatorCallbacks(options);
+		return source;
+	}
 
-ACL_UNITY_API void* compressScalarsClip(signed short numTracks, 
-										signed short compressionLevel, 
-										const float* clipData, 
-										int numSamples, 
-										float sampleRate,
-										float* maxErrors, 
-										int* outCompressedSizeInBytes)
-{
-	ansi_allocator allocator;;
+	typedef std::chrono::high_resolution_clock Clock;
 
-	track_array_float1f trackArray(allocator, static_cast<uint32_t>(numTracks));
-	for (short i = 0; i < numTracks; i++)
+	float getElapsedSeconds(Clock::time_point start)
 	{
-		track_desc_scalarf trackDesc;
-		trackDesc.output_index = static_cast<uint32_t>(i);
-		trackDesc.precision    = maxErrors[i];
-		trackArray[i] = track_float1f::make_copy(trackDesc, allocator, clipData + i * numSamples, static_cast<uint32_t>(numSamples), sampleRate);
+		return std::chrono::duration<float>(Clock::now() - start).count();
 	}
 
-	auto compressionSettings = get_default_compression_settings();
-	compressionSettings.level = static_cast<compression_level8>(compressionLevel);
+	void writeTransformStatistics(const compressed_tracks& compressedTracks, CompressionStatistics& outStatistics)
+	{
+		const acl_impl::transform_tracks_header& header = acl_impl::get_transform_tracks_header(compressedTracks);
+		const int numTracks = static_cast<int>(compressedTracks.get_num_tracks());
 
-	pre_process_settings_t settings;
-	pre_process_track_list(allocator, settings, trackArray);
+		outStatistics.numSegments                      = static_cast<int>(header.num_segments);
+		outStatistics.numAnimatedRotationSubTracks     = static_cast<int>(header.num_animated_rotation_sub_tracks);
+		outStatistics.numAnimatedTranslationSubTracks  = static_cast<int>(header.num_animated_translation_sub_tracks);
+		outStatistics.numAnimatedScaleSubTracks        = static_cast<int>(header.num_animated_scale_sub_tracks);
+		outStatistics.numConstantRotationSubTracks     = static_cast<int>(header.num_constant_rotation_samples);
+		outStatistics.numConstantTranslationSubTracks  = static_cast<int>(header.num_constant_translation_samples);
+		outStatistics.numConstantScaleSubTracks        = static_cast<int>(header.num_constant_scale_samples);
+		outStatistics.numDefaultRotationSubTracks      = numTracks - outStatistics.numAnimatedRotationSubTracks - outStatistics.numConstantRotationSubTracks;
+		outStatistics.numDefaultTranslationSubTracks   = numTracks - outStatistics.numAnimatedTranslationSubTracks - outStatistics.numConstantTranslationSubTracks;
+		outStatistics.numDefaultScaleSubTracks         = numTracks - outStatistics.numAnimatedScaleSubTracks - outStatistics.numConstantScaleSubTracks;
+	}
 
-	compressed_tracks* outCompressedTracks = nullptr;
-	output_stats outputStats;
+	void buildSkeletonTracks(const SkeletonClipSource& source, iallocator& allocator, track_array_qvvf& outTrackArray)
+	{
+		track_desc_transformf trackDesc;
+		trackDesc.precision = source.maxDistanceError;
+		for (short i = 0; i < source.numBones; i++)
+		{
+			trackDesc.output_index   = static_cast<uint32_t>(i);
+			trackDesc.parent_index   = resolveParentIndex(source.parentIndices, i);
+			trackDesc.shell_distance = source.shellDistances[i];
+			if (source.defaultPose != nullptr)
+			{
+				const float* bone = source.defaultPose + 12 * i;
+				trackDesc.default_value = rtm::qvv_set(rtm::quat_load(bone), rtm::vector_load(bone + 4), rtm::vector_load(bone + 8));
+			}
+			const uint32_t stride = static_cast<uint32_t>(source.clip.sampleStride * sizeof(rtm::qvvf));
+			// Pre-processing writes through a reference, so only memory which may be consumed is referenced
+			if (source.mutableClipData != nullptr)
+				outTrackArray[i] = track_qvvf::make_ref(trackDesc, source.mutableClipData + source.clip.indexOf(i, 0), static_cast<uint32_t>(source.numSamples), source.sampleRate, stride);
+			else
+				outTrackArray[i] = track_qvvf::make_copy(trackDesc, allocator, &source.clip.get(i, 0), static_cast<uint32_t>(source.numSamples), source.sampleRate, stride);
+		}
+	}
 
-	compress_track_list(allocator, trackArray, compressionSettings, outCompressedTracks, outputStats);
-	*outCompressedSizeInBytes = outCompressedTracks->get_size();
+	// ACL offers no way to abort a compression. Once cancelled, every error check passes instead, so ACL settles on its first
+	// choice for each remaining decision and returns quickly. The result of a cancelled compression is discarded.
+	template<typename ErrorMetric>
+	class CancellableErrorMetric : public ErrorMetric
+	{
+	private:
+		const std::atomic<bool>* m_isCancelled;
 
-	return outCompressedTracks;
-}
+	public:
+		template<typename... Args>
+		CancellableErrorMetric(const std::atomic<bool>* isCancelled, Args... args) : ErrorMetric(args...), m_isCancelled(isCancelled) {}
 
-ACL_UNITY_API void disposeCompressedTracksBuffer(void* compressedTracksBuffer)
-{
-	ansi_allocator a;
-	compressed_tracks* buffer = static_cast<compressed_tracks*>(compressedTracksBuffer);
-	a.deallocate(buffer, buffer->get_size());
+		virtual RTM_DISABLE_SECURITY_COOKIE_CHECK rtm::scalarf RTM_SIMD_CALL calculate_error(const typename ErrorMetric::calculate_error_args& args) const override
+		{
+			if (m_isCancelled != nullptr && m_isCancelled->load(std::memory_order_relaxed))
+				return rtm::scalar_set(0.f);
+			return ErrorMetric::calculate_error(args);
+		}
+
+		virtual RTM_DISABLE_SECURITY_COOKIE_CHECK rtm::scalarf RTM_SIMD_CALL calculate_error_no_scale(const typename ErrorMetric::calculate_error_args& args) const override
+		{
+			if (m_isCancelled != nullptr && m_isCancelled->load(std::memory_order_relaxed))
+				return rtm::scalar_set(0.f);
+			return ErrorMetric::calculate_error_no_scale(args);
+		}
+	};
+
+	// Selects the error metric matching whether the clip has sampled uniform scales
+	class SkeletonErrorMetric
+	{
+	private:
+		CancellableErrorMetric<QvvsNoScaleTransformErrorMetric> m_noScaleMetric;
+		CancellableErrorMetric<QvvsTransformErrorMetric>        m_scaleMetric;
+		bool                                                    m_hasScales;
+
+	public:
+		SkeletonErrorMetric(const SkeletonClipSource& source, const std::atomic<bool>* isCancelled) :
+			m_noScaleMetric(isCancelled),
+			m_scaleMetric(isCancelled, source.sampledScales, static_cast<size_t>(source.numBones)),
+			m_hasScales(source.sampledScales != nullptr)
+		{}
+
+		itransform_error_metric* get() { return m_hasScales ? static_cast<itransform_error_metric*>(&m_scaleMetric) : &m_noScaleMetric; }
+	};
+
+	compression_settings makeCompressionSettings(const SkeletonClipSource& source, itransform_error_metric* errorMetric)
+	{
+		auto compressionSettings         = get_default_compression_settings();
+		compressionSettings.level        = static_cast<compression_level8>(source.compressionLevel);
+		compressionSettings.error_metric = errorMetric;
+		// Zero keeps the ACL defaults
+		if (source.idealSegmentSize > 0)
+			compressionSettings.segmenting.ideal_num_samples = static_cast<uint32_t>(source.idealSegmentSize);
+		if (source.maxSegmentSize > 0)
+			compressionSettings.segmenting.max_num_samples = static_cast<uint32_t>(source.maxSegmentSize);
+		// ACL rejects a maximum below the ideal, which the default maximum would otherwise be for large ideal sizes
+		compressionSettings.segmenting.max_num_samples = std::max(compressionSettings.segmenting.max_num_samples, compressionSettings.segmenting.ideal_num_samples);
+		compressionSettings.enable_database_support = source.enableDatabase;
+		if (source.stripProportion > 0.f || source.stripThreshold > 0.f)
+		{
+			compressionSettings.keyframe_stripping.enabled    = true;
+			compressionSettings.keyframe_stripping.proportion = std::min(source.stripProportion, 1.f);
+			compressionSettings.keyframe_stripping.threshold  = std::max(source.stripThreshold, 0.f);
+		}
+		return compressionSettings;
+	}
+
+	void writeSkeletonStatistics(iallocator&                allocator,
+								 const track_array_qvvf&    trackArray,
+								 const compressed_tracks&   compressedTracks,
+								 itransform_error_metric&   errorMetric,
+								 Clock::time_point          startTime,
+								 CompressionStatistics&     outStatistics)
+	{
+		outStatistics = CompressionStatistics();
+		outStatistics.compressionTimeInSeconds = getElapsedSeconds(startTime);
+		outStatistics.rawSizeInBytes           = static_cast<int>(trackArray.get_num_tracks() * trackArray.get_num_samples_per_track() * sizeof(rtm::qvvf));
+		outStatistics.compressedSizeInBytes    = static_cast<int>(compressedTracks.get_size());
+		writeTransformStatistics(compressedTracks, outStatistics);
+		// Measured outside of the timed region since it decompresses every sample
+		const track_error error = calculate_compression_error(allocator, trackArray, compressedTracks, errorMetric);
+		outStatistics.maxError     = error.error;
+		outStatistics.maxErrorBone = static_cast<int>(error.index);
+		outStatistics.maxErrorTime = error.sample_time;
+	}
+
+	enum CompressionStage
+	{
+		kCompressionStageQueued        = 0,
+		kCompressionStageBuilding      = 1,
+		kCompressionStagePreProcessing = 2,
+		kCompressionStageCompressing   = 3,
+		kCompressionStageFinished      = 4,
+	};
+
+	// Lets an asynchronous job observe and cancel the compression it runs
+	struct CompressionProgress
+	{
+		std::atomic<bool> isCancelled;
+		std::atomic<int>  stage;
+
+		CompressionProgress() : isCancelled(false), stage(kCompressionStageQueued) {}
+	};
+
+	compressed_tracks* compressSkeletonClipSource(const SkeletonClipSource& source, CompressionStatistics* outStatistics, CompressionProgress* progress = nullptr)
+	{
+		const Clock::time_point startTime = Clock::now();
+		CompressionAllocator allocator(source.allocatorCallbacks);
+
+		if (progress != nullptr)
+			progress->stage.store(kCompressionStageBuilding);
+		track_array_qvvf trackArray(allocator, static_cast<uint32_t>(source.numBones));
+		buildSkeletonTracks(source, allocator, trackArray);
+
+		SkeletonErrorMetric errorMetric(source, progress == nullptr ? nullptr : &progress->isCancelled);
+		auto compressionSettings = makeCompressionSettings(source, errorMetric.get());
+
+		if (progress != nullptr)
+			progress->stage.store(kCompressionStagePreProcessing);
+		pre_process_settings_t settings;
+		settings.error_metric = compressionSettings.error_metric;
+		pre_process_track_list(allocator, settings, trackArray);
+
+		if (progress != nullptr)
+		{
+			if (progress->isCancelled.load())
+				return nullptr;
+			progress->stage.store(kCompressionStageCompressing);
+		}
+		compressed_tracks* outCompressedTracks = nullptr;
+		output_stats outputStats;
+
+		compress_track_list(allocator, trackArray, compressionSettings, outCompressedTracks, outputStats);
+
+		if (outStatistics != nullptr)
+			writeSkeletonStatistics(allocator, trackArray, *outCompressedTracks, *compressionSettings.error_metric, startTime, *outStatistics);
+		return outCompressedTracks;
+	}
+
+	// Scale tracks only exist in compressSkeletonClipTuned to time their decoding, so their precision only needs to be
+	// representative of the tight tolerances uniform scales are usually compressed with.
+	const float kTimedScalePrecision = 0.00001f;
+
+	// Times the runtime sampling path by decoding poses spread evenly across the clip. The sampler matches the one the clip
+	// needs at runtime, so clips with a default pose or scale tracks include their cost as well.
+	// When coldCache is set, the cache is flushed before each decode so that memory traffic is included in the cost.
+	float measureSamplePoseNanoseconds(const compressed_tracks& compressedTracks, const compressed_tracks* scaleTracks, const float* defaultPose, int numDecodes, bool coldCache)
+	{
+		if (numDecodes <= 0)
+			return 0.f;
+
+		std::vector<float> pose(static_cast<size_t>(compressedTracks.get_num_tracks()) * 12);
+		const float duration = compressedTracks.get_duration();
+		auto timeAt = [&](int decodeIndex) { return numDecodes == 1 ? 0.f : duration * static_cast<float>(decodeIndex) / static_cast<float>(numDecodes - 1); };
+		auto decode = [&](float time)
+		{
+			if (defaultPose != nullptr)
+				samplePoseWithDefaults(&compressedTracks, scaleTracks, defaultPose, pose.data(), time, 0);
+			else
+				samplePose(&compressedTracks, scaleTracks, pose.data(), time, 0);
+		};
+
+		// Larger than the last level cache of current desktop, console, and mobile CPUs
+		const size_t evictionSize = coldCache ? 32 * 1024 * 1024 : 0;
+		std::vector<unsigned char> evictionBuffer(evictionSize);
+		volatile unsigned char*    eviction = evictionBuffer.data();
+
+		// The warm-up pass keeps first-touch page faults out of the measurement
+		for (int i = 0; i < numDecodes; i++)
+			decode(timeAt(i));
+
+		std::chrono::duration<double, std::nano> elapsed(0.0);
+		for (int i = 0; i < numDecodes; i++)
+		{
+			if (coldCache)
+			{
+				for (size_t offset = 0; offset < evictionSize; offset += 64)
+					eviction[offset]++;
+			}
+
+			const Clock::time_point start = Clock::now();
+			decode(timeAt(i));
+			elapsed += Clock::now() - start;
+		}
+		return static_cast<float>(elapsed.count() / numDecodes);
+	}
+
+	// Returns the bones ordered such that every parent precedes its children
+	std::vector<short> getParentFirstBoneOrder(const signed short* parentIndices, signed short numBones)
+	{
+		std::vector<short> depths(static_cast<size_t>(numBones), 0);
+		for (short i = 0; i < numBones; i++)
+		{
+			short depth = 0;
+			uint32_t parent = resolveParentIndex(parentIndices, i);
+			// The depth can never exceed the bone count unless the hierarchy contains a cycle
+			for (; parent != k_invalid_track_index && depth < numBones; depth++)
+				parent = resolveParentIndex(parentIndices, static_cast<short>(parent));
+			depths[i] = depth;
+		}
+
+		std::vector<short> order(static_cast<size_t>(numBones));
+		for (short i = 0; i < numBones; i++)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [&](short a, short b) { return depths[a] < depths[b]; });
+		return order;
+	}
+
+	// Converts local transforms into object space using the same math as QvvsNoScaleTransformErrorMetric
+	void localToObjectSpace(const signed short* parentIndices, const std::vector<short>& boneOrder, const rtm::qvvf* localTransforms, rtm::qvvf* outObjectTransforms)
+	{
+		for (short boneIndex : boneOrder)
+		{
+			const uint32_t parentIndex = resolveParentIndex(parentIndices, boneIndex);
+			if (parentIndex == k_invalid_track_index)
+				outObjectTransforms[boneIndex] = localTransforms[boneIndex];
+			else
+				outObjectTransforms[boneIndex] = rtm::qvv_normalize(qvvsMul(localTransforms[boneIndex], outObjectTransforms[parentIndex]));
+		}
+	}
+
+	// Default sub-tracks take their value from the default pose the clip was compressed with, or the identity without one
+	class QvvsTransformWriter : public track_writer
+	{
+	private:
+		rtm::qvvf*   m_outputTransforms;
+		const float* m_defaultPose;
+
+	public:
+		QvvsTransformWriter(rtm::qvvf* outputTransforms, const float* defaultPose) : m_outputTransforms(outputTransforms), m_defaultPose(defaultPose) {}
+
+		static constexpr default_sub_track_mode get_rotation_default_mode() { return default_sub_track_mode::variable; }
+		static constexpr default_sub_track_mode get_translation_default_mode() { return default_sub_track_mode::variable; }
+		static constexpr default_sub_track_mode get_scale_default_mode() { return default_sub_track_mode::variable; }
+
+		rtm::quatf RTM_SIMD_CALL get_variable_default_rotation(uint32_t track_index) const
+		{
+			return m_defaultPose == nullptr ? rtm::quat_identity() : rtm::quat_load(m_defaultPose + 12 * track_index);
+		}
+
+		rtm::vector4f RTM_SIMD_CALL get_variable_default_translation(uint32_t track_index) const
+		{
+			return m_defaultPose == nullptr ? rtm::vector_zero() : rtm::vector_load(m_defaultPose + 12 * track_index + 4);
+		}
+
+		rtm::vector4f RTM_SIMD_CALL get_variable_default_scale(uint32_t track_index) const
+		{
+			return m_defaultPose == nullptr ? rtm::vector_set(1.f) : rtm::vector_load(m_defaultPose + 12 * track_index + 8);
+		}
+
+		RTM_FORCE_INLINE void RTM_SIMD_CALL write_rotation(uint32_t track_index, rtm::quatf_arg0 rotation)
+		{
+			m_outputTransforms[track_index].rotation = rotation;
+		}
+
+		RTM_FORCE_INLINE void RTM_SIMD_CALL write_translation(uint32_t track_index, rtm::vector4f_arg0 translation)
+		{
+			m_outputTransforms[track_index].translation = translation;
+		}
+
+		RTM_FORCE_INLINE void RTM_SIMD_CALL write_scale(uint32_t track_index, rtm::vector4f_arg0 scale)
+		{
+			m_outputTransforms[track_index].scale = rtm::vector_set_w(scale, 1.f);
+		}
+	};
+
+	class QvvsUniformScaleWriter : public track_writer
+	{
+	private:
+		rtm::qvvf* m_outputTransforms;
+
+	public:
+		QvvsUniformScaleWriter(rtm::qvvf* outputTransforms) : m_outputTransforms(outputTransforms) {}
+
+		RTM_FORCE_INLINE void RTM_SIMD_CALL write_float1(uint32_t track_index, rtm::scalarf_arg0 value)
+		{
+			m_outputTransforms[track_index].scale = rtm::vector_set_w(m_outputTransforms[track_index].scale, rtm::scalar_cast(value));
+		}
+	};
+
+	class SampledScaleWriter : public track_writer
+	{
+	private:
+		float* m_outputBuffer;
+
+	public:
+		SampledScaleWriter(float* outputBuffer) : m_outputBuffer(outputBuffer) {}
+
+		RTM_FORCE_INLINE void RTM_SIMD_CALL write_float1(uint32_t track_index, rtm::scalarf_arg0 value)
+		{
+			rtm::scalar_store(value, m_outputBuffer + track_index);
+		}
+	};
+
+	// Decompresses every sample of the uniform scale tracks into the frame-major layout expected by QvvsTransformErrorMetric
+	void sampleCompressedScales(const compressed_tracks& scaleTracks, int numSamples, float sampleRate, float* outSampledScales)
+	{
+		FloatDecompressionContext context;
+		context.initialize(scaleTracks);
+		const size_t numTracks = scaleTracks.get_num_tracks();
+		for (int sampleIndex = 0; sampleIndex < numSamples; sampleIndex++)
+		{
+			context.seek(static_cast<float>(sampleIndex) / sampleRate, sample_rounding_policy::nearest);
+			SampledScaleWriter writer(outSampledScales + sampleIndex * numTracks);
+			context.decompress_tracks(writer);
+		}
+	}
+
+	size_t alignTo16(size_t size)
+	{
+		return (size + 15) & ~static_cast<size_t>(15);
+	}
+
+	// A clip is static when ACL found no animated transform sub-track and every decompressed uniform scale matches the first sample.
+	// Constant sub-tracks decompress to the same value at any time, so a single decompressed pose then reproduces every sample exactly.
+	bool isStaticPose(const compressed_tracks& transformTracks, const float* sampledScales, short numBones, int numSamples)
+	{
+		const acl_impl::transform_tracks_header& header = acl_impl::get_transform_tracks_header(transformTracks);
+		if (header.num_animated_rotation_sub_tracks != 0 || header.num_animated_translation_sub_tracks != 0 || header.num_animated_scale_sub_tracks != 0)
+			return false;
+
+		const size_t numValues = static_cast<size_t>(numBones) * static_cast<size_t>(numSamples);
+		for (size_t i = static_cast<size_t>(numBones); i < numValues; i++)
+		{
+			if (sampledScales[i] != sampledScales[i % numBones])
+				return false;
+		}
+		return true;
+	}
+
+	// Packs the compressed parts of a clip behind a CompressedClipHeader and disposes the parts
+	void* packCompressedClip(iallocator&        allocator,
+							 compressed_tracks* transformTracks,
+							 compressed_tracks* scaleTracks,
+							 compressed_tracks* scalarTracks,
+							 short              numBones,
+							 const float*       staticPose,
+							 const float*       defaultPose,
+							 int*               outCompressedSizeInBytes)
+	{
+		static_assert(sizeof(CompressedClipHeader) == 32, "The header must preserve the 16 byte alignment of the parts which follow it");
+
+		CompressedClipHeader header = CompressedClipHeader();
+		header.layoutTag = ACL_UNITY_COMPRESSED_CLIP_LAYOUT_TAG;
+		header.numBones = numBones;
+		size_t totalSize = sizeof(CompressedClipHeader);
+		header.transformTracksOffset = static_cast<int>(totalSize);
+		totalSize += alignTo16(transformTracks->get_size());
+		if (scaleTracks != nullptr)
+		{
+			header.scaleTracksOffset = static_cast<int>(totalSize);
+			totalSize += alignTo16(scaleTracks->get_size());
+		}
+		if (scalarTracks != nullptr)
+		{
+			header.scalarTracksOffset = static_cast<int>(totalSize);
+			totalSize += alignTo16(scalarTracks->get_size());
+		}
+		const size_t poseSize = static_cast<size_t>(numBones) * 12 * sizeof(float);
+		if (staticPose != nullptr)
+		{
+			header.staticPoseOffset = static_cast<int>(totalSize);
+			totalSize += poseSize;
+		}
+		// A static pose already includes the default values, so the default pose is never read
+		else if (defaultPose != nullptr)
+		{
+			header.defaultPoseOffset = static_cast<int>(totalSize);
+			totalSize += poseSize;
+		}
+		header.totalSizeInBytes = static_cast<int>(totalSize);
+
+		uint8_t* blob = static_cast<uint8_t*>(allocator.allocate(totalSize, 16));
+		std::memset(blob, 0, totalSize);
+		std::memcpy(blob, &header, sizeof(header));
+		std::memcpy(blob + header.transformTracksOffset, transformTracks, transformTracks->get_size());
+		allocator.deallocate(transformTracks, transformTracks->get_size());
+		if (scaleTracks != nullptr)
+		{
+			std::memcpy(blob + header.scaleTracksOffset, scaleTracks, scaleTracks->get_size());
+			allocator.deallocate(scaleTracks, scaleTracks->get_size());
+		}
+		if (scalarTracks != nullptr)
+		{
+			std::memcpy(blob + header.scalarTracksOffset, scalarTracks, scalarTracks->get_size());
+			allocator.deallocate(scalarTracks, scalarTracks->get_size());
+		}
+		if (header.staticPoseOffset != 0)
+			std::memcpy(blob + header.staticPoseOffset, staticPose, poseSize);
+		if (header.defaultPoseOffset != 0)
+			std::memcpy(blob + header.defaultPoseOffset, defaultPose, poseSize);
+
+		*outCompressedSizeInBytes = header.totalSizeInBytes;
+		return blob;
+	}
+
+	struct SampleError
+	{
+		float error;
+		int   boneIndex;
+		int   sampleIndex;
+	};
+
+	// Owns copies of all inputs so that the caller may release its source data as soon as the job begins.
+	struct CompressionJob
+	{
+		std::vector<signed short>       parentIndices;
+		std::vector<rtm::qvvf>          clipData;
+		std::vector<float>              sampledScales;
+		std::vector<float>              defaultPose;
+		std::vector<float>              shellDistances;
+		AllocatorCallbacks              allocatorCallbacks;
+		SkeletonClipSource              source;
+
+		compressed_tracks*              result;
+		CompressionProgress             progress;
+		bool                            isFinished;
+		std::mutex                      mutex;
+		std::condition_variable         finished;
+
+		CompressionJob() : result(nullptr), isFinished(false) {}
+
+		void run()
+		{
+			if (!progress.isCancelled.load())
+				result = compressSkeletonClipSource(source, nullptr, &progress);
+			progress.stage.store(kCompressionStageFinished);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			isFinished = true;
+			finished.notify_all();
+		}
+	};
+
+	typedef std::shared_ptr<CompressionJob> CompressionJobHandle;
+
+	// consumableClipData is either nullptr or aosClipData, in which case ACL pre-processes the caller's samples in place
+	compressed_tracks* compressSkeletonClipData(const signed short*       parentIndices,
+												signed short              numBones,
+												signed short              compressionLevel,
+												const float*              aosClipData,
+												float*                    consumableClipData,
+												int                       numSamples,
+												float                     sampleRate,
+												float                     maxDistanceError,
+												float                     sampledErrorDistanceFromBone,
+												float*                    sampledScales,
+												const CompressionOptions* options)
+	{
+		CompressionAllocator allocator(getAllocatorCallbacks(options));
+		RawClipData          rawClipData(allocator, aosClipData, numBones, numSamples, getClipDataLayout(options));
+
+		std::vector<float> shellDistances(static_cast<size_t>(numBones));
+		initializeShellDistances(parentIndices, numBones, rawClipData.getView(), numSamples, sampledErrorDistanceFromBone, options, shellDistances.data());
+
+		SkeletonClipSource source = makeSkeletonClipSource(options,
+															parentIndices,
+															numBones,
+															compressionLevel,
+															rawClipData.getView(),
+															numSamples,
+															sampleRate,
+															maxDistanceError,
+															shellDistances.data(),
+															sampledScales);
+		source.mutableClipData = rawClipData.getScratch() != nullptr ? rawClipData.getScratch() : reinterpret_cast<rtm::qvvf*>(consumableClipData);
+
+		return compressSkeletonClipSource(source, options == nullptr ? nullptr : options->outStatistics);
+	}
+}
+
+ACL_UNITY_API void* compressSkeletonClip(const signed short* parentIndices, 
+										 signed short        numBones, 
+										 signed short        compressionLevel, 
+										 const float*        aosClipData, 
+										 int                 numSamples, 
+										 float               sampleRate, 
+										 float               maxDistanceError, 
+										 float               sampledErrorDistanceFromBone, 
+										 int*                outCompressedSizeInBytes,
+										 float*              sampledScales)
+{
+	return compressSkeletonClipWithOptions(parentIndices,
+										   numBones,
+										   compressionLevel,
+										   aosClipData,
+										   numSamples,
+										   sampleRate,
+										   maxDistanceError,
+										   sampledErrorDistanceFromBone,
+										   outCompressedSizeInBytes,
+										   sampledScales,
+										   nullptr);
+}
+
+ACL_UNITY_API void* compressSkeletonClipWithOptions(const signed short*       parentIndices,
+													signed short              numBones,
+													signed short              compressionLevel,
+													const float*              aosClipData,
+													int                       numSamples,
+													float                     sampleRate,
+													float                     maxDistanceError,
+													float                     sampledErrorDistanceFromBone,
+													int*                      outCompressedSizeInBytes,
+													float*                    sampledScales,
+													const CompressionOptions* options)
+{
+	compressed_tracks* outCompressedTracks = compressSkeletonClipData(parentIndices,
+																	   numBones,
+																	   compressionLevel,
+																	   aosClipData,
+																	   nullptr,
+																	   numSamples,
+																	   sampleRate,
+																	   maxDistanceError,
+																	   sampledErrorDistanceFromBone,
+																	   sampledScales,
+																	   options);
+	*outCompressedSizeInBytes = outCompressedTracks->get_size();
+	
+	return outCompressedTracks;
+}
+
+ACL_UNITY_API void* compressSkeletonClipInPlace(const signed short*       parentIndices,
+												signed short              numBones,
+												signed short              compressionLevel,
+												float*                    aosClipData,
+												int                       numSamples,
+												float                     sampleRate,
+												float                     maxDistanceError,
+												float                     sampledErrorDistanceFromBone,
+												int*                      outCompressedSizeInBytes,
+												float*                    sampledScales,
+												const CompressionOptions* options)
+{
+	compressed_tracks* outCompressedTracks = compressSkeletonClipData(parentIndices,
+																	   numBones,
+																	   compressionLevel,
+																	   aosClipData,
+																	   aosClipData,
+																	   numSamples,
+																	   sampleRate,
+																	   maxDistanceError,
+																	   sampledErrorDistanceFromBone,
+																	   sampledScales,
+																	   options);
+	*outCompressedSizeInBytes = outCompressedTracks->get_size();
+
+	return outCompressedTracks;
+}
+
+ACL_UNITY_API void* compressSkeletonClipToBudget(const signed short*       parentIndices,
+												  signed short              numBones,
+												  signed short              compressionLevel,
+												  const float*              aosClipData,
+												  int                       numSamples,
+												  float                     sampleRate,
+												  int                       targetSizeInBytes,
+												  float                     targetBytesPerSecond,
+												  float                     minDistanceError,
+												  float                     maxDistanceError,
+												  int                       maxIterations,
+												  float                     sampledErrorDistanceFromBone,
+												  int*                      outCompressedSizeInBytes,
+												  float*                    outAchievedDistanceError,
+												  float*                    sampledScales,
+												  const CompressionOptions* options)
+{
+	const Clock::time_point startTime = Clock::now();
+	CompressionAllocator allocator(getAllocatorCallbacks(options));
+	RawClipData          rawClipData(allocator, aosClipData, numBones, numSamples, getClipDataLayout(options));
+
+	std::vector<float> shellDistances(static_cast<size_t>(numBones));
+	initializeShellDistances(parentIndices, numBones, rawClipData.getView(), numSamples, sampledErrorDistanceFromBone, options, shellDistances.data());
+
+	// Pre-processing only makes changes which are safe at the precision it is given,
+	// so pre-processing once at the tightest candidate precision is valid for every iteration.
+	SkeletonClipSource source = makeSkeletonClipSource(options,
+														parentIndices,
+														numBones,
+														compressionLevel,
+														rawClipData.getView(),
+														numSamples,
+														sampleRate,
+														minDistanceError,
+														shellDistances.data(),
+														sampledScales);
+	source.mutableClipData = rawClipData.getScratch();
+
+	track_array_qvvf trackArray(allocator, static_cast<uint32_t>(numBones));
+	buildSkeletonTracks(source, allocator, trackArray);
+
+	SkeletonErrorMetric errorMetric(source, nullptr);
+	auto compressionSettings = makeCompressionSettings(source, errorMetric.get());
+
+	pre_process_settings_t preProcessSettings;
+	preProcessSettings.error_metric = compressionSettings.error_metric;
+	pre_process_track_list(allocator, preProcessSettings, trackArray);
+
+	size_t budget = targetSizeInBytes > 0 ? static_cast<size_t>(targetSizeInBytes) : 0;
+	if (budget == 0 && targetBytesPerSecond > 0.f)
+		budget = static_cast<size_t>(targetBytesPerSecond * trackArray.get_duration());
+
+	auto compressAt = [&](float distanceError) -> compressed_tracks*
+	{
+		for (short i = 0; i < numBones; i++)
+			trackArray[i].get_description().precision = distanceError;
+
+		compressed_tracks* compressedTracks = nullptr;
+		output_stats outputStats;
+		compress_track_list(allocator, trackArray, compressionSettings, compressedTracks, outputStats);
+		return compressedTracks;
+	};
+
+	auto dispose = [&](compressed_tracks* compressedTracks)
+	{
+		if (compressedTracks != nullptr)
+			allocator.deallocate(compressedTracks, compressedTracks->get_size());
+	};
+
+	// The loosest precision is tried first. If even that exceeds the budget, higher compression levels are tried
+	// since they produce smaller output for the same error. Automatic compression is never escalated.
+	compressed_tracks* best = nullptr;
+	float bestError = maxDistanceError;
+	short level = compressionLevel;
+	for (;;)
+	{
+		compressionSettings.level = static_cast<compression_level8>(level);
+		dispose(best);
+		best = compressAt(maxDistanceError);
+		const bool canEscalate = level >= 0 && level < static_cast<short>(compression_level8::highest);
+		if (budget == 0 || best->get_size() <= budget || !canEscalate)
+			break;
+		level++;
+	}
+
+	if (budget != 0 && best->get_size() <= budget && minDistanceError < maxDistanceError)
+	{
+		compressed_tracks* candidate = compressAt(minDistanceError);
+		if (candidate->get_size() <= budget)
+		{
+			dispose(best);
+			best = candidate;
+			bestError = minDistanceError;
+		}
+		else
+		{
+			dispose(candidate);
+
+			// Errors span several orders of magnitude, so the search bisects in log space
+			float fitsError = maxDistanceError;
+			float exceedsError = minDistanceError;
+			for (int iteration = 0; iteration < maxIterations; iteration++)
+			{
+				const float distanceError = exceedsError > 0.f ? std::sqrt(fitsError * exceedsError) : 0.5f * (fitsError + exceedsError);
+				candidate = compressAt(distanceError);
+				if (candidate->get_size() <= budget)
+				{
+					dispose(best);
+					best = candidate;
+					fitsError = distanceError;
+				}
+				else
+				{
+					dispose(candidate);
+					exceedsError = distanceError;
+				}
+			}
+			bestError = fitsError;
+		}
+	}
+
+	if (options != nullptr && options->outStatistics != nullptr)
+		writeSkeletonStatistics(allocator, trackArray, *best, *compressionSettings.error_metric, startTime, *options->outStatistics);
+
+	*outCompressedSizeInBytes = best->get_size();
+	if (outAchievedDistanceError != nullptr)
+		*outAchievedDistanceError = bestError;
+	return best;
+}
+
+ACL_UNITY_API void* compressSkeletonClipTuned(const signed short*           parentIndices,
+											   signed short                  numBones,
+											   const float*                  aosClipData,
+											   int                           numSamples,
+											   float                         sampleRate,
+											   float                         maxDistanceError,
+											   float                         sampledErrorDistanceFromBone,
+											   int*                          outCompressedSizeInBytes,
+											   float*                        sampledScales,
+											   const CompressionOptions*     options,
+											   const CompressionCandidate*   candidates,
+											   int                           numCandidates,
+											   float                         bytesPerDecodeNanosecond,
+											   int                           numDecodes,
+											   int                           coldCache,
+											   int                           maxThreads,
+											   CompressionCandidateResult*   outResults,
+											   int*                          outChosenCandidate)
+{
+	*outCompressedSizeInBytes = 0;
+	if (numCandidates <= 0)
+		return nullptr;
+
+	CompressionAllocator allocator(getAllocatorCallbacks(options));
+	RawClipData          rawClipData(allocator, aosClipData, numBones, numSamples, getClipDataLayout(options));
+
+	std::vector<float> shellDistances(static_cast<size_t>(numBones));
+	initializeShellDistances(parentIndices, numBones, rawClipData.getView(), numSamples, sampledErrorDistanceFromBone, options, shellDistances.data());
+
+	// Candidates compress concurrently, so they must never pre-process the same memory
+	const SkeletonClipSource source = makeSkeletonClipSource(options,
+															  parentIndices,
+															  numBones,
+															  0,
+															  rawClipData.getView(),
+															  numSamples,
+															  sampleRate,
+															  maxDistanceError,
+															  shellDistances.data(),
+															  sampledScales);
+
+	std::vector<compressed_tracks*>    compressed(static_cast<size_t>(numCandidates), nullptr);
+	std::vector<CompressionStatistics> statistics(static_cast<size_t>(numCandidates));
+	AclUnity::ThreadPool::instance().parallelFor(static_cast<uint32_t>(numCandidates), static_cast<uint32_t>(std::max(maxThreads, 0)), [&](uint32_t candidateIndex)
+	{
+		SkeletonClipSource candidateSource = source;
+		candidateSource.compressionLevel   = candidates[candidateIndex].compressionLevel;
+		if (candidates[candidateIndex].idealSamplesPerSegment > 0)
+			candidateSource.idealSegmentSize = candidates[candidateIndex].idealSamplesPerSegment;
+		if (candidates[candidateIndex].maxSamplesPerSegment > 0)
+			candidateSource.maxSegmentSize = candidates[candidateIndex].maxSamplesPerSegment;
+		compressed[candidateIndex] = compressSkeletonClipSource(candidateSource, &statistics[candidateIndex]);
+	});
+
+	// Every candidate shares the scale tracks, which are only compressed so that their decode cost is part of each timing
+	compressed_tracks* scaleTracks = nullptr;
+	if (sampledScales != nullptr && numDecodes > 0)
+	{
+		std::vector<float> rawScales(static_cast<size_t>(numBones) * static_cast<size_t>(numSamples));
+		for (short i = 0; i < numBones; i++)
+		{
+			for (int s = 0; s < numSamples; s++)
+				rawScales[static_cast<size_t>(i) * numSamples + s] = sampledScales[static_cast<size_t>(s) * numBones + i];
+		}
+
+		CompressionOptions scaleOptions = CompressionOptions();
+		scaleOptions.allocator = getAllocatorCallbacks(options);
+		std::vector<float> maxErrors(static_cast<size_t>(numBones), kTimedScalePrecision);
+		int scaleSizeInBytes = 0;
+		scaleTracks = static_cast<compressed_tracks*>(compressScalarsClipWithOptions(numBones, 0, rawScales.data(), numSamples, sampleRate, maxErrors.data(), &scaleSizeInBytes, &scaleOptions));
+	}
+	const float* defaultPose = options == nullptr ? nullptr : options->defaultPose;
+
+	// Decodes are timed one candidate at a time on the calling thread so that candidates don't compete for caches
+	int   chosen = 0;
+	float chosenScore = 0.f;
+	for (int i = 0; i < numCandidates; i++)
+	{
+		const float decodeNanoseconds = measureSamplePoseNanoseconds(*compressed[i], scaleTracks, defaultPose, numDecodes, coldCache != 0);
+		const float score = static_cast<float>(compressed[i]->get_size()) + bytesPerDecodeNanosecond * decodeNanoseconds;
+		if (i == 0 || score < chosenScore)
+		{
+			chosen = i;
+			chosenScore = score;
+		}
+
+		if (outResults != nullptr)
+		{
+			outResults[i].compressedSizeInBytes   = static_cast<int>(compressed[i]->get_size());
+			outResults[i].maxError                = statistics[i].maxError;
+			outResults[i].decodeTimeInNanoseconds = decodeNanoseconds;
+			outResults[i].numSegments             = statistics[i].numSegments;
+		}
+	}
+
+	for (int i = 0; i < numCandidates; i++)
+	{
+		if (i != chosen)
+			allocator.deallocate(compressed[i], compressed[i]->get_size());
+	}
+	if (scaleTracks != nullptr)
+		allocator.deallocate(scaleTracks, scaleTracks->get_size());
+
+	if (options != nullptr && options->outStatistics != nullptr)
+		*options->outStatistics = statistics[chosen];
+	if (outChosenCandidate != nullptr)
+		*outChosenCandidate = chosen;
+	*outCompressedSizeInBytes = compressed[chosen]->get_size();
+	return compressed[chosen];
+}
+
+ACL_UNITY_API void benchmarkSkeletonClipSegmentSizes(const signed short*         parentIndices,
+													   signed short                numBones,
+													   signed short                compressionLevel,
+													   const float*                aosClipData,
+													   int                         numSamples,
+													   float                       sampleRate,
+													   float                       maxDistanceError,
+													   float                       sampledErrorDistanceFromBone,
+													   float*                      sampledScales,
+													   const CompressionOptions*   options,
+													   const int*                  idealSamplesPerSegment,
+													   int                         numSegmentSizes,
+													   int                         numDecodes,
+													   int                         coldCache,
+													   int                         maxThreads,
+													   CompressionCandidateResult* outResults)
+{
+	if (numSegmentSizes <= 0)
+		return;
+
+	// ACL's defaults allow segments to grow to just under twice their ideal size, so each candidate keeps that ratio
+	std::vector<CompressionCandidate> candidates(static_cast<size_t>(numSegmentSizes));
+	for (int i = 0; i < numSegmentSizes; i++)
+	{
+		candidates[i].compressionLevel       = compressionLevel;
+		candidates[i].idealSamplesPerSegment = idealSamplesPerSegment[i];
+		candidates[i].maxSamplesPerSegment   = idealSamplesPerSegment[i] * 2 - 1;
+	}
+
+	CompressionOptions benchmarkOptions = options == nullptr ? CompressionOptions() : *options;
+	benchmarkOptions.outStatistics = nullptr;
+
+	int compressedSizeInBytes = 0;
+	void* chosen = compressSkeletonClipTuned(parentIndices,
+											 numBones,
+											 aosClipData,
+											 numSamples,
+											 sampleRate,
+											 maxDistanceError,
+											 sampledErrorDistanceFromBone,
+											 &compressedSizeInBytes,
+											 sampledScales,
+											 &benchmarkOptions,
+											 candidates.data(),
+											 numSegmentSizes,
+											 0.f,
+											 numDecodes,
+											 coldCache,
+											 maxThreads,
+											 outResults,
+											 nullptr);
+	disposeCompressedTracksBufferWithAllocator(chosen, getAllocatorCallbacks(options));
+}
+
+ACL_UNITY_API void* compressSkeletonClipWithScales(const signed short*       parentIndices,
+													signed short              numBones,
+													signed short              compressionLevel,
+													const float*              aosClipData,
+													int                       numSamples,
+													float                     sampleRate,
+													float                     maxDistanceError,
+													float                     sampledErrorDistanceFromBone,
+													float                     maxUniformScaleError,
+													float                     uniformScaleTolerance,
+													int*                      outCompressedSizeInBytes,
+													const CompressionOptions* options)
+{
+	return compressSkeletonClipWithCurves(parentIndices,
+										  numBones,
+										  compressionLevel,
+										  aosClipData,
+										  numSamples,
+										  sampleRate,
+										  maxDistanceError,
+										  sampledErrorDistanceFromBone,
+										  maxUniformScaleError,
+										  uniformScaleTolerance,
+										  0,
+										  nullptr,
+										  nullptr,
+										  outCompressedSizeInBytes,
+										  options);
+}
+
+ACL_UNITY_API void* compressSkeletonClipWithCurves(const signed short*       parentIndices,
+												   signed short              numBones,
+												   signed short              compressionLevel,
+												   const float*              aosClipData,
+												   int                       numSamples,
+												   float                     sampleRate,
+												   float                     maxDistanceError,
+												   float                     sampledErrorDistanceFromBone,
+												   float                     maxUniformScaleError,
+												   float                     uniformScaleTolerance,
+												   signed short              numCurves,
+												   const float*              curveClipData,
+												   float*                    curveMaxErrors,
+												   int*                      outCompressedSizeInBytes,
+												   const CompressionOptions* options)
+{
+	CompressionAllocator allocator(getAllocatorCallbacks(options));
+
+	// Uniform scales are gathered track-major for scalar compression
+	const size_t numValues = static_cast<size_t>(numBones) * static_cast<size_t>(numSamples);
+	std::vector<float> rawScales(numValues);
+	bool hasScales = false;
+	{
+		RawClipData rawClipData(allocator, aosClipData, numBones, numSamples, getClipDataLayout(options));
+		const ClipDataView& clip = rawClipData.getView();
+		for (short i = 0; i < numBones; i++)
+		{
+			for (int s = 0; s < numSamples; s++)
+			{
+				const float scale = rtm::vector_get_w(clip.get(i, s).scale);
+				rawScales[static_cast<size_t>(i) * numSamples + s] = scale;
+				hasScales |= std::abs(scale - 1.f) > uniformScaleTolerance;
+			}
+		}
+	}
+
+	// When the scale clip is dropped, the error metric still measures against a uniform scale of exactly 1 so that
+	// any scale within the tolerance is accounted for in the transform error.
+	std::vector<float> sampledScales(numValues, 1.f);
+	compressed_tracks* scaleTracks = nullptr;
+	if (hasScales)
+	{
+		CompressionOptions scaleOptions = options == nullptr ? CompressionOptions() : *options;
+		scaleOptions.outStatistics = nullptr;
+		std::vector<float> maxErrors(static_cast<size_t>(numBones), maxUniformScaleError);
+		int scaleSizeInBytes = 0;
+		scaleTracks = static_cast<compressed_tracks*>(compressScalarsClipWithOptions(numBones, compressionLevel, rawScales.data(), numSamples, sampleRate, maxErrors.data(), &scaleSizeInBytes, &scaleOptions));
+		sampleCompressedScales(*scaleTracks, numSamples, sampleRate, sampledScales.data());
+	}
+
+	int transformSizeInBytes = 0;
+	compressed_tracks* transformTracks = static_cast<compressed_tracks*>(compressSkeletonClipWithOptions(parentIndices,
+																									   numBones,
+																									   compressionLevel,
+																									   aosClipData,
+																									   numSamples,
+																									   sampleRate,
+																									   maxDistanceError,
+																									   sampledErrorDistanceFromBone,
+																									   &transformSizeInBytes,
+																									   sampledScales.data(),
+																									   options));
+
+	compressed_tracks* scalarTracks = nullptr;
+	if (numCurves > 0)
+	{
+		CompressionOptions curveOptions = options == nullptr ? CompressionOptions() : *options;
+		curveOptions.outStatistics = nullptr;
+		int scalarSizeInBytes = 0;
+		scalarTracks = static_cast<compressed_tracks*>(compressScalarsClipWithOptions(numCurves, compressionLevel, curveClipData, numSamples, sampleRate, curveMaxErrors, &scalarSizeInBytes, &curveOptions));
+	}
+
+	const float* defaultPose = options == nullptr ? nullptr : options->defaultPose;
+	std::vector<float> staticPose;
+	if (isStaticPose(*transformTracks, sampledScales.data(), numBones, numSamples))
+	{
+		staticPose.resize(static_cast<size_t>(numBones) * 12);
+		const unsigned char nearest = static_cast<unsigned char>(sample_rounding_policy::nearest);
+		if (defaultPose != nullptr)
+			samplePoseWithDefaults(transformTracks, scaleTracks, defaultPose, staticPose.data(), 0.f, nearest);
+		else
+			samplePose(transformTracks, scaleTracks, staticPose.data(), 0.f, nearest);
+	}
+
+	return packCompressedClip(allocator, transformTracks, scaleTracks, scalarTracks, numBones, staticPose.empty() ? nullptr : staticPose.data(), defaultPose, outCompressedSizeInBytes);
+}
+
+ACL_UNITY_API void compressSkeletonClipBatch(const signed short*           parentIndices,
+											 signed short                  numBones,
+											 const SkeletonClipDescriptor* clips,
+											 int                           numClips,
+											 const CompressionOptions*     options,
+											 int                           maxThreads,
+											 void**                        outCompressedBuffers,
+											 int*                          outCompressedSizesInBytes)
+{
+	if (numClips <= 0)
+		return;
+
+	// Clips are handed out one at a time so that a few long clips don't leave the remaining threads idle.
+	AclUnity::ThreadPool::instance().parallelFor(static_cast<uint32_t>(numClips), static_cast<uint32_t>(std::max(maxThreads, 0)), [&](uint32_t clipIndex)
+	{
+		const SkeletonClipDescriptor& clip = clips[clipIndex];
+		CompressionOptions clipOptions = options == nullptr ? CompressionOptions() : *options;
+		clipOptions.outStatistics = clip.outStatistics;
+		outCompressedBuffers[clipIndex] = compressSkeletonClipWithOptions(parentIndices,
+																		  numBones,
+																		  clip.compressionLevel,
+																		  clip.aosClipData,
+																		  clip.numSamples,
+																		  clip.sampleRate,
+																		  clip.maxDistanceError,
+																		  clip.sampledErrorDistanceFromBone,
+																		  outCompressedSizesInBytes + clipIndex,
+																		  clip.sampledScales,
+																		  &clipOptions);
+	});
+}
+
+ACL_UNITY_API void* beginCompressSkeletonClip(const signed short*       parentIndices,
+											  signed short              numBones,
+											  signed short              compressionLevel,
+											  const float*              aosClipData,
+											  int                       numSamples,
+											  float                     sampleRate,
+											  float                     maxDistanceError,
+											  float                     sampledErrorDistanceFromBone,
+											  float*                    sampledScales,
+											  const CompressionOptions* options)
+{
+	CompressionJobHandle job = std::make_shared<CompressionJob>();
+
+	const size_t numValues = static_cast<size_t>(numBones) * static_cast<size_t>(numSamples);
+	const int    layout    = getClipDataLayout(options);
+	job->parentIndices.assign(parentIndices, parentIndices + numBones);
+	// SOA data is transposed while copying, which leaves it frame-major
+	job->clipData.resize(numValues);
+	if (layout == kClipDataLayoutSoa)
+		transposeSoaClipData(aosClipData, numBones, numSamples, job->clipData.data());
+	else
+		std::memcpy(job->clipData.data(), aosClipData, numValues * sizeof(rtm::qvvf));
+	const ClipDataView clip = makeClipDataView(job->clipData.data(), numBones, numSamples, layout != kClipDataLayoutBoneMajor);
+	if (sampledScales != nullptr)
+		job->sampledScales.assign(sampledScales, sampledScales + numValues);
+	if (options != nullptr && options->defaultPose != nullptr)
+		job->defaultPose.assign(options->defaultPose, options->defaultPose + static_cast<size_t>(numBones) * 12);
+	job->shellDistances.resize(static_cast<size_t>(numBones));
+	initializeShellDistances(parentIndices, numBones, clip, numSamples, sampledErrorDistanceFromBone, options, job->shellDistances.data());
+
+	// Every pointer is redirected to the job's copies, since the caller may release its data before the job finishes
+	SkeletonClipSource& source = job->source;
+	source = makeSkeletonClipSource(options,
+									job->parentIndices.data(),
+									numBones,
+									compressionLevel,
+									clip,
+									numSamples,
+									sampleRate,
+									maxDistanceError,
+									job->shellDistances.data(),
+									sampledScales == nullptr ? nullptr : job->sampledScales.data());
+	source.defaultPose     = job->defaultPose.empty() ? nullptr : job->defaultPose.data();
+	source.mutableClipData = job->clipData.data();
+	if (source.allocatorCallbacks != nullptr)
+	{
+		job->allocatorCallbacks   = *source.allocatorCallbacks;
+		source.allocatorCallbacks = &job->allocatorCallbacks;
+	}
+
+	AclUnity::ThreadPool::instance().enqueue([job]() { job->run(); });
+	return new CompressionJobHandle(job);
+}
+
+ACL_UNITY_API int pollCompression(void* compressionJob, int* outStage)
+{
+	CompressionJob& job = **static_cast<CompressionJobHandle*>(compressionJob);
+	if (outStage != nullptr)
+		*outStage = job.progress.stage.load();
+
+	std::lock_guard<std::mutex> lock(job.mutex);
+	return job.isFinished ? 1 : 0;
+}
+
+ACL_UNITY_API void cancelCompression(void* compressionJob)
+{
+	CompressionJob& job = **static_cast<CompressionJobHandle*>(compressionJob);
+	job.progress.isCancelled.store(true);
+}
+
+ACL_UNITY_API void* endCompression(void* compressionJob, int* outCompressedSizeInBytes)
+{
+	CompressionJobHandle* handle = static_cast<CompressionJobHandle*>(compressionJob);
+	CompressionJob& job = **handle;
+	compressed_tracks* result;
+	{
+		std::unique_lock<std::mutex> lock(job.mutex);
+		job.finished.wait(lock, [&job]() { return job.isFinished; });
+		result = job.result;
+		job.result = nullptr;
+	}
+
+	// Disposed here rather than by whichever thread releases the job last, since the caller's allocator is only guaranteed to outlive this call
+	if (result != nullptr && job.progress.isCancelled.load())
+	{
+		CompressionAllocator allocator(job.source.allocatorCallbacks);
+		allocator.deallocate(result, result->get_size());
+		result = nullptr;
+	}
+
+	*outCompressedSizeInBytes = result == nullptr ? 0 : static_cast<int>(result->get_size());
+	delete handle;
+	return result;
+}
+
+ACL_UNITY_API float measureSkeletonClipError(const signed short*       parentIndices,
+											  signed short              numBones,
+											  const float*              aosClipData,
+											  int                       numSamples,
+											  const void*               compressedTransformTracks,
+											  const void*               compressedScaleTracks,
+											  float                     sampledErrorDistanceFromBone,
+											  const CompressionOptions* options,
+											  int                       maxThreads,
+											  float*                    outPerBoneMaxErrors,
+											  float*                    outPerSampleMaxErrors,
+											  int                       numHistogramBuckets,
+											  float                     histogramMaxError,
+											  int*                      outPerBoneHistograms,
+											  int*                      outWorstBone,
+											  int*                      outWorstSample)
+{
+	CompressionAllocator allocator(getAllocatorCallbacks(options));
+	RawClipData          rawClipData(allocator, aosClipData, numBones, numSamples, getClipDataLayout(options));
+	const ClipDataView&  clip = rawClipData.getView();
+
+	std::vector<float> shellDistances(static_cast<size_t>(numBones));
+	initializeShellDistances(parentIndices, numBones, clip, numSamples, sampledErrorDistanceFromBone, options, shellDistances.data());
+
+	const std::vector<short> boneOrder = getParentFirstBoneOrder(parentIndices, numBones);
+
+	const compressed_tracks* transformTracks = static_cast<const compressed_tracks*>(compressedTransformTracks);
+	const compressed_tracks* scaleTracks = static_cast<const compressed_tracks*>(compressedScaleTracks);
+	const float sampleRate = transformTracks->get_sample_rate();
+	const int   numCompressedSamples = std::min(numSamples, static_cast<int>(transformTracks->get_num_samples_per_track()));
+
+	// Samples are split into blocks so that each thread reuses its decompression contexts and scratch poses
+	const int samplesPerBlock = 32;
+	const int numBlocks = (numCompressedSamples + samplesPerBlock - 1) / samplesPerBlock;
+	std::vector<float>       blockBoneErrors(static_cast<size_t>(numBlocks) * numBones, 0.f);
+	std::vector<SampleError> blockWorstErrors(static_cast<size_t>(numBlocks));
+
+	const int    numBuckets      = outPerBoneHistograms != nullptr && numHistogramBuckets > 0 ? numHistogramBuckets : 0;
+	const size_t histogramSize   = static_cast<size_t>(numBones) * static_cast<size_t>(numBuckets);
+	const float  bucketsPerError = histogramMaxError > 0.f ? static_cast<float>(numBuckets) / histogramMaxError : 0.f;
+	std::vector<int> blockHistograms(static_cast<size_t>(numBlocks) * histogramSize, 0);
+
+	AclUnity::ThreadPool::instance().parallelFor(static_cast<uint32_t>(numBlocks), static_cast<uint32_t>(std::max(maxThreads, 0)), [&](uint32_t blockIndex)
+	{
+		std::vector<rtm::qvvf> rawLocal(static_cast<size_t>(numBones));
+		std::vector<rtm::qvvf> rawObject(static_cast<size_t>(numBones));
+		std::vector<rtm::qvvf> lossyLocal(static_cast<size_t>(numBones));
+		std::vector<rtm::qvvf> lossyObject(static_cast<size_t>(numBones));
+
+		TransformDecompressionContext transformContext;
+		transformContext.initialize(*transformTracks);
+		FloatDecompressionContext scaleContext;
+		if (scaleTracks != nullptr)
+			scaleContext.initialize(*scaleTracks);
+
+		QvvsTransformWriter    transformWriter(lossyLocal.data(), options == nullptr ? nullptr : options->defaultPose);
+		QvvsUniformScaleWriter scaleWriter(lossyLocal.data());
+
+		float* boneErrors = blockBoneErrors.data() + static_cast<size_t>(blockIndex) * numBones;
+		int*   histograms = blockHistograms.data() + static_cast<size_t>(blockIndex) * histogramSize;
+		SampleError worst = { -1.f, 0, 0 };
+
+		const int firstSample = static_cast<int>(blockIndex) * samplesPerBlock;
+		const int lastSample = std::min(firstSample + samplesPerBlock, numCompressedSamples);
+		for (int sampleIndex = firstSample; sampleIndex < lastSample; sampleIndex++)
+		{
+			const float time = static_cast<float>(sampleIndex) / sampleRate;
+			transformContext.seek(time, sample_rounding_policy::nearest);
+			transformContext.decompress_tracks(transformWriter);
+			if (scaleTracks != nullptr)
+			{
+				scaleContext.seek(time, sample_rounding_policy::nearest);
+				scaleContext.decompress_tracks(scaleWriter);
+			}
+
+			for (short i = 0; i < numBones; i++)
+				rawLocal[i] = clip.get(i, sampleIndex);
+
+			localToObjectSpace(parentIndices, boneOrder, rawLocal.data(), rawObject.data());
+			localToObjectSpace(parentIndices, boneOrder, lossyLocal.data(), lossyObject.data());
+
+			float sampleMaxError = 0.f;
+			for (short i = 0; i < numBones; i++)
+			{
+				const rtm::vector4f vtx0 = rtm::vector_set(shellDistances[i], 0.f, 0.f, 0.f);
+				const rtm::vector4f vtx1 = rtm::vector_set(0.f, shellDistances[i], 0.f, 0.f);
+				const rtm::vector4f vtx2 = rtm::vector_set(0.f, 0.f, shellDistances[i], 0.f);
+				const float error = rtm::scalar_cast(calculateShellError(rawObject[i], lossyObject[i], vtx0, vtx1, vtx2));
+
+				boneErrors[i] = std::max(boneErrors[i], error);
+				sampleMaxError = std::max(sampleMaxError, error);
+				if (numBuckets > 0)
+				{
+					// The last bucket also counts every error at or beyond histogramMaxError
+					const int bucket = static_cast<int>(std::min(error * bucketsPerError, static_cast<float>(numBuckets - 1)));
+					histograms[static_cast<size_t>(i) * numBuckets + bucket]++;
+				}
+				if (error > worst.error)
+				{
+					worst.error       = error;
+					worst.boneIndex   = i;
+					worst.sampleIndex = sampleIndex;
+				}
+			}
+
+			if (outPerSampleMaxErrors != nullptr)
+				outPerSampleMaxErrors[sampleIndex] = sampleMaxError;
+		}
+
+		blockWorstErrors[blockIndex] = worst;
+	});
+
+	// Blocks are reduced serially in order so that ties always resolve to the earliest sample
+	SampleError worst = { 0.f, 0, 0 };
+	for (int blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+	{
+		if (blockWorstErrors[blockIndex].error > worst.error)
+			worst = blockWorstErrors[blockIndex];
+	}
+
+	if (outPerBoneMaxErrors != nullptr)
+	{
+		std::fill(outPerBoneMaxErrors, outPerBoneMaxErrors + numBones, 0.f);
+		for (int blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+		{
+			const float* boneErrors = blockBoneErrors.data() + static_cast<size_t>(blockIndex) * numBones;
+			for (short i = 0; i < numBones; i++)
+				outPerBoneMaxErrors[i] = std::max(outPerBoneMaxErrors[i], boneErrors[i]);
+		}
+	}
+
+	if (numBuckets > 0)
+	{
+		std::fill(outPerBoneHistograms, outPerBoneHistograms + histogramSize, 0);
+		for (int blockIndex = 0; blockIndex < numBlocks; blockIndex++)
+		{
+			const int* histograms = blockHistograms.data() + static_cast<size_t>(blockIndex) * histogramSize;
+			for (size_t i = 0; i < histogramSize; i++)
+				outPerBoneHistograms[i] += histograms[i];
+		}
+	}
+
+	if (outWorstBone != nullptr)
+		*outWorstBone = worst.boneIndex;
+	if (outWorstSample != nullptr)
+		*outWorstSample = worst.sampleIndex;
+	return worst.error;
+}
+
+ACL_UNITY_API void* compressScalarsClip(signed short numTracks, 
+										signed short compressionLevel, 
+										const float* clipData, 
+										int numSamples, 
+										float sampleRate,
+										float* maxErrors, 
+										int* outCompressedSizeInBytes)
+{
+	return compressScalarsClipWithOptions(numTracks, compressionLevel, clipData, numSamples, sampleRate, maxErrors, outCompressedSizeInBytes, nullptr);
+}
+
+ACL_UNITY_API void* compressScalarsClipWithOptions(signed short              numTracks,
+												   signed short              compressionLevel,
+												   const float*              clipData,
+												   int                       numSamples,
+												   float                     sampleRate,
+												   float*                    maxErrors,
+												   int*                      outCompressedSizeInBytes,
+												   const CompressionOptions* options)
+{
+	const Clock::time_point startTime = Clock::now();
+	CompressionAllocator allocator(getAllocatorCallbacks(options));
+
+	track_array_float1f trackArray(allocator, static_cast<uint32_t>(numTracks));
+	for (short i = 0; i < numTracks; i++)
+	{
+		track_desc_scalarf trackDesc;
+		trackDesc.output_index = static_cast<uint32_t>(i);
+		trackDesc.precision    = maxErrors[i];
+		trackArray[i] = track_float1f::make_copy(trackDesc, allocator, clipData + i * numSamples, static_cast<uint32_t>(numSamples), sampleRate);
+	}
+
+	auto compressionSettings = get_default_compression_settings();
+	compressionSettings.level = static_cast<compression_level8>(compressionLevel);
+
+	pre_process_settings_t settings;
+	pre_process_track_list(allocator, settings, trackArray);
+
+	compressed_tracks* outCompressedTracks = nullptr;
+	output_stats outputStats;
+
+	compress_track_list(allocator, trackArray, compressionSettings, outCompressedTracks, outputStats);
+	*outCompressedSizeInBytes = outCompressedTracks->get_size();
+
+	if (options != nullptr && options->outStatistics != nullptr)
+	{
+		CompressionStatistics& stats = *options->outStatistics;
+		stats = CompressionStatistics();
+		stats.compressionTimeInSeconds = getElapsedSeconds(startTime);
+		stats.rawSizeInBytes           = numTracks * numSamples * static_cast<int>(sizeof(float));
+		stats.compressedSizeInBytes    = static_cast<int>(outCompressedTracks->get_size());
+		const track_error error = calculate_compression_error(allocator, trackArray, *outCompressedTracks);
+		stats.maxError     = error.error;
+		stats.maxErrorBone = static_cast<int>(error.index);
+		stats.maxErrorTime = error.sample_time;
+	}
+
+	return outCompressedTracks;
+}
+
+ACL_UNITY_API void* buildSkeletonClipDatabase(const void* const*        compressedTransformTracks,
+											  int                       numClips,
+											  float                     mediumTierProportion,
+											  float                     lowTierProportion,
+											  void**                    outCompressedTransformTracks,
+											  int*                      outDatabaseSizeInBytes,
+											  void**                    outMediumTierBulkData,
+											  int*                      outMediumTierSizeInBytes,
+											  void**                    outLowTierBulkData,
+											  int*                      outLowTierSizeInBytes,
+											  const AllocatorCallbacks* allocatorCallbacks)
+{
+	if (numClips <= 0)
+		return nullptr;
+
+	CompressionAllocator allocator(allocatorCallbacks);
+
+	std::vector<const compressed_tracks*> inputTracks(static_cast<size_t>(numClips));
+	for (int i = 0; i < numClips; i++)
+		inputTracks[i] = static_cast<const compressed_tracks*>(compressedTransformTracks[i]);
+
+	compression_database_settings settings;
+	settings.medium_importance_tier_proportion = mediumTierProportion;
+	settings.low_importance_tier_proportion    = lowTierProportion;
+
+	std::vector<compressed_tracks*> outputTracks(static_cast<size_t>(numClips), nullptr);
+	compressed_database* database = nullptr;
+	if (build_database(allocator, settings, inputTracks.data(), static_cast<uint32_t>(numClips), outputTracks.data(), database).any())
+		return nullptr;
+
+	// ACL builds the tiers inline. Splitting them out lets each tier be stored and streamed independently of the metadata.
+	compressed_database* splitDatabase = nullptr;
+	uint8_t* mediumTierBulkData = nullptr;
+	uint8_t* lowTierBulkData = nullptr;
+	const error_result splitResult = split_database_bulk_data(allocator, *database, splitDatabase, mediumTierBulkData, lowTierBulkData);
+	allocator.deallocate(database, database->get_size());
+	if (splitResult.any())
+	{
+		for (compressed_tracks* tracks : outputTracks)
+			allocator.deallocate(tracks, tracks->get_size());
+		return nullptr;
+	}
+
+	for (int i = 0; i < numClips; i++)
+		outCompressedTransformTracks[i] = outputTracks[i];
+	*outDatabaseSizeInBytes   = static_cast<int>(splitDatabase->get_size());
+	*outMediumTierBulkData    = mediumTierBulkData;
+	*outMediumTierSizeInBytes = static_cast<int>(splitDatabase->get_bulk_data_size(quality_tier::medium_importance));
+	*outLowTierBulkData       = lowTierBulkData;
+	*outLowTierSizeInBytes    = static_cast<int>(splitDatabase->get_bulk_data_size(quality_tier::lowest_importance));
+	return splitDatabase;
+}
+
+ACL_UNITY_API void disposeCompressedTracksBuffer(void* compressedTracksBuffer)
+{
+	disposeCompressedTracksBufferWithAllocator(compressedTracksBuffer, nullptr);
+}
+
+ACL_UNITY_API void disposeCompressedTracksBufferWithAllocator(void* compressedTracksBuffer, const AllocatorCallbacks* allocatorCallbacks)
+{
+	CompressionAllocator a(allocatorCallbacks);
+	compressed_tracks* buffer = static_cast<compressed_tracks*>(compressedTracksBuffer);
+	a.deallocate(buffer, buffer->get_size());
+}
+
+ACL_UNITY_API void disposeCompressedClip(void* compressedClip, const AllocatorCallbacks* allocatorCallbacks)
+{
+	CompressionAllocator a(allocatorCallbacks);
+	a.deallocate(compressedClip, static_cast<size_t>(static_cast<const CompressedClipHeader*>(compressedClip)->totalSizeInBytes));
+}
+
+ACL_UNITY_API void disposeDatabaseBuffer(void* databaseBuffer, int sizeInBytes, const AllocatorCallbacks* allocatorCallbacks)
+{
+	CompressionAllocator allocator(allocatorCallbacks);
+	allocator.deallocate(databaseBuffer, static_cast<size_t>(sizeInBytes));
 }
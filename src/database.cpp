@@ -0,0 +1,199 @@
+#include "database.h"
+
+#include "database_file_streamer.h"
+#include "database_runtime.h"
+
+#include <cstring>
+
+using namespace acl;
+using AclUnity::DatabaseFileStreamer;
+using AclUnity::DatabaseFileTierStreamer;
+using AclUnity::DatabaseRuntime;
+
+namespace
+{
+	// Streams a tier from a caller-owned copy. The resident copy is allocated when the first chunk streams in
+	// and released when the last chunk streams out, so a fully streamed out tier costs no memory beyond the source.
+	class MemoryDatabaseStreamer final : public idatabase_streamer
+	{
+	private:
+		iallocator&    m_allocator;
+		const uint8_t* m_source;
+		uint32_t       m_sizeInBytes;
+		uint8_t*       m_bulkData;
+
+	public:
+		MemoryDatabaseStreamer(iallocator& allocator, const void* source, int sizeInBytes) :
+			m_allocator(allocator),
+			m_source(static_cast<const uint8_t*>(source)),
+			m_sizeInBytes(source == nullptr ? 0 : static_cast<uint32_t>(sizeInBytes)),
+			m_bulkData(nullptr)
+		{}
+
+		virtual ~MemoryDatabaseStreamer() override
+		{
+			m_allocator.deallocate(m_bulkData, m_sizeInBytes);
+		}
+
+		virtual bool is_initialized() const override { return true; }
+
+		virtual const uint8_t* get_bulk_data() const override { return m_bulkData; }
+
+		virtual void stream_in(uint32_t offset, uint32_t size, bool can_allocate_bulk_data, const std::function<void(bool success)>& continuation) override
+		{
+			if (m_source == nullptr || static_cast<uint64_t>(offset) + size > m_sizeInBytes)
+			{
+				continuation(false);
+				return;
+			}
+
+			if (can_allocate_bulk_data && m_bulkData == nullptr)
+				m_bulkData = static_cast<uint8_t*>(m_allocator.allocate(m_sizeInBytes, 16));
+			std::memcpy(m_bulkData + offset, m_source + offset, size);
+			continuation(true);
+		}
+
+		virtual void stream_out(uint32_t offset, uint32_t size, bool can_deallocate_bulk_data, const std::function<void(bool success)>& continuation) override
+		{
+			(void)offset;
+			(void)size;
+			if (can_deallocate_bulk_data)
+			{
+				m_allocator.deallocate(m_bulkData, m_sizeInBytes);
+				m_bulkData = nullptr;
+			}
+			continuation(true);
+		}
+	};
+
+	bool getQualityTier(int tier, quality_tier& outTier)
+	{
+		switch (tier)
+		{
+		case 1:
+			outTier = quality_tier::medium_importance;
+			return true;
+		case 2:
+			outTier = quality_tier::lowest_importance;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	uint32_t getNumChunksToStream(int numChunks)
+	{
+		return numChunks <= 0 ? ~0U : static_cast<uint32_t>(numChunks);
+	}
+
+	bool isStreamRequestAccepted(database_stream_request_result result)
+	{
+		return result == database_stream_request_result::done || result == database_stream_request_result::dispatched;
+	}
+}
+
+ACL_UNITY_API void* createDatabaseContext(const void* compressedDatabase, const void* mediumTierBulkData, int mediumTierSizeInBytes, const void* lowTierBulkData, int lowTierSizeInBytes)
+{
+	if (mediumTierSizeInBytes < 0 || lowTierSizeInBytes < 0)
+		return nullptr;
+	const compressed_database* database = make_compressed_database(compressedDatabase);
+	if (database == nullptr)
+		return nullptr;
+
+	DatabaseRuntime* runtime = new DatabaseRuntime();
+	runtime->mediumTierStreamer.reset(new MemoryDatabaseStreamer(runtime->allocator, mediumTierBulkData, mediumTierSizeInBytes));
+	runtime->lowTierStreamer.reset(new MemoryDatabaseStreamer(runtime->allocator, lowTierBulkData, lowTierSizeInBytes));
+	if (!runtime->context.initialize(runtime->allocator, *database, *runtime->mediumTierStreamer, *runtime->lowTierStreamer))
+	{
+		delete runtime;
+		return nullptr;
+	}
+	return runtime;
+}
+
+ACL_UNITY_API void* createDatabaseFileStreamer(const char* path, long long memoryBudgetInBytes)
+{
+	return DatabaseFileStreamer::open(path, memoryBudgetInBytes <= 0 ? 0 : static_cast<uint64_t>(memoryBudgetInBytes));
+}
+
+ACL_UNITY_API void* createFileDatabaseContext(void*       databaseFileStreamer,
+											  const void* compressedDatabase,
+											  long long   mediumTierFileOffset,
+											  int         mediumTierSizeInBytes,
+											  long long   lowTierFileOffset,
+											  int         lowTierSizeInBytes)
+{
+	if (mediumTierFileOffset < 0 || mediumTierSizeInBytes < 0 || lowTierFileOffset < 0 || lowTierSizeInBytes < 0)
+		return nullptr;
+	const compressed_database* database = make_compressed_database(compressedDatabase);
+	if (database == nullptr)
+		return nullptr;
+
+	DatabaseFileStreamer& fileStreamer = *static_cast<DatabaseFileStreamer*>(databaseFileStreamer);
+	DatabaseRuntime* runtime = new DatabaseRuntime();
+	runtime->mediumTierStreamer.reset(new DatabaseFileTierStreamer(fileStreamer, runtime->allocator, static_cast<uint64_t>(mediumTierFileOffset), static_cast<uint32_t>(mediumTierSizeInBytes)));
+	runtime->lowTierStreamer.reset(new DatabaseFileTierStreamer(fileStreamer, runtime->allocator, static_cast<uint64_t>(lowTierFileOffset), static_cast<uint32_t>(lowTierSizeInBytes)));
+	if (!runtime->context.initialize(runtime->allocator, *database, *runtime->mediumTierStreamer, *runtime->lowTierStreamer))
+	{
+		delete runtime;
+		return nullptr;
+	}
+	fileStreamer.registerContext(*runtime);
+	return runtime;
+}
+
+ACL_UNITY_API void getDatabaseFileStreamerStatistics(void* databaseFileStreamer, DatabaseStreamingStatistics* outStatistics)
+{
+	static_cast<DatabaseFileStreamer*>(databaseFileStreamer)->getStatistics(*outStatistics);
+}
+
+ACL_UNITY_API void destroyDatabaseFileStreamer(void* databaseFileStreamer)
+{
+	delete static_cast<DatabaseFileStreamer*>(databaseFileStreamer);
+}
+
+ACL_UNITY_API int streamInDatabaseTier(void* databaseContext, int tier, int numChunks)
+{
+	quality_tier qualityTier;
+	if (!getQualityTier(tier, qualityTier))
+		return 0;
+
+	DatabaseRuntime* runtime = static_cast<DatabaseRuntime*>(databaseContext);
+	if (runtime->fileStreamer == nullptr)
+		return isStreamRequestAccepted(runtime->context.stream_in(qualityTier, getNumChunksToStream(numChunks))) ? 1 : 0;
+
+	if (!runtime->fileStreamer->beginStreamIn(*runtime, qualityTier))
+		return 0;
+	const bool isAccepted = isStreamRequestAccepted(runtime->context.stream_in(qualityTier, getNumChunksToStream(numChunks)));
+	runtime->fileStreamer->endStreamIn(*runtime, qualityTier);
+	return isAccepted ? 1 : 0;
+}
+
+ACL_UNITY_API int streamOutDatabaseTier(void* databaseContext, int tier, int numChunks)
+{
+	quality_tier qualityTier;
+	if (!getQualityTier(tier, qualityTier))
+		return 0;
+
+	DatabaseRuntime* runtime = static_cast<DatabaseRuntime*>(databaseContext);
+	return isStreamRequestAccepted(runtime->context.stream_out(qualityTier, getNumChunksToStream(numChunks))) ? 1 : 0;
+}
+
+ACL_UNITY_API int isDatabaseTierStreamedIn(const void* databaseContext, int tier)
+{
+	quality_tier qualityTier;
+	if (!getQualityTier(tier, qualityTier))
+		return 0;
+
+	const DatabaseRuntime* runtime = static_cast<const DatabaseRuntime*>(databaseContext);
+	return runtime->context.is_streamed_in(qualityTier) ? 1 : 0;
+}
+
+ACL_UNITY_API void destroyDatabaseContext(void* databaseContext)
+{
+	DatabaseRuntime* runtime = static_cast<DatabaseRuntime*>(databaseContext);
+	if (runtime->fileStreamer != nullptr)
+		runtime->fileStreamer->unregisterContext(*runtime);
+	runtime->context.reset();
+	delete runtime;
+}
@@ -0,0 +1,361 @@
+// Makes off_t 64 bits wide on 32-bit glibc so that fopen and fseeko handle files past 2 GB. It must precede every include.
+// Bionic only declares fseeko for a 64-bit off_t from API level 24, so 32-bit Android reads with pread64 instead.
+#if !defined(_WIN32) && !defined(__ANDROID__) && !defined(_FILE_OFFSET_BITS)
+#define _FILE_OFFSET_BITS 64
+#endif
+
+#include "database_file_streamer.h"
+
+#include "database_runtime.h"
+
+#include <algorithm>
+
+#if defined(__ANDROID__)
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <sys/types.h>
+static_assert(sizeof(off_t) >= sizeof(uint64_t), "Tier offsets past 2 GB would be truncated by a 32-bit off_t");
+#endif
+
+using namespace acl;
+
+namespace AclUnity
+{
+	namespace
+	{
+		DatabaseFileTierStreamer& getTierStreamer(DatabaseRuntime& runtime, quality_tier tier)
+		{
+			idatabase_streamer* streamer = tier == quality_tier::medium_importance ? runtime.mediumTierStreamer.get() : runtime.lowTierStreamer.get();
+			return *static_cast<DatabaseFileTierStreamer*>(streamer);
+		}
+
+		bool isEvictable(DatabaseRuntime& runtime, quality_tier tier)
+		{
+			return getTierStreamer(runtime, tier).get_bulk_data() != nullptr && !runtime.context.is_streaming(tier);
+		}
+	}
+
+	DatabaseFileTierStreamer::DatabaseFileTierStreamer(DatabaseFileStreamer& fileStreamer, iallocator& allocator, uint64_t fileOffset, uint32_t sizeInBytes) :
+		m_fileStreamer(fileStreamer),
+		m_allocator(allocator),
+		m_fileOffset(fileOffset),
+		m_sizeInBytes(sizeInBytes),
+		m_bulkData(nullptr),
+		m_isReserved(false),
+		m_numPendingReads(0),
+		m_numLoadedReads(0)
+	{}
+
+	DatabaseFileTierStreamer::~DatabaseFileTierStreamer()
+	{
+		m_allocator.deallocate(m_bulkData, m_sizeInBytes);
+		if (m_isReserved)
+			m_fileStreamer.release(m_sizeInBytes);
+	}
+
+	void DatabaseFileTierStreamer::stream_in(uint32_t offset, uint32_t size, bool can_allocate_bulk_data, const std::function<void(bool success)>& continuation)
+	{
+		if (static_cast<uint64_t>(offset) + size > m_sizeInBytes)
+		{
+			continuation(false);
+			return;
+		}
+
+		// A tier reclaimed after failed reads is allocated again even if ACL expects its memory to remain
+		(void)can_allocate_bulk_data;
+		if (m_bulkData == nullptr)
+			m_bulkData = static_cast<uint8_t*>(m_allocator.allocate(m_sizeInBytes, 16));
+		m_fileStreamer.enqueueRead(*this, offset, size, continuation);
+	}
+
+	void DatabaseFileTierStreamer::stream_out(uint32_t offset, uint32_t size, bool can_deallocate_bulk_data, const std::function<void(bool success)>& continuation)
+	{
+		(void)offset;
+		(void)size;
+		if (can_deallocate_bulk_data)
+		{
+			m_allocator.deallocate(m_bulkData, m_sizeInBytes);
+			m_bulkData = nullptr;
+			{
+				std::lock_guard<std::mutex> lock(m_fileStreamer.m_mutex);
+				m_numLoadedReads = 0;
+			}
+			if (m_isReserved)
+			{
+				m_fileStreamer.release(m_sizeInBytes);
+				m_isReserved = false;
+			}
+		}
+		continuation(true);
+	}
+
+	DatabaseFileStreamer::DatabaseFileStreamer(std::FILE* file, uint64_t memoryBudget) :
+		m_file(file),
+		m_memoryBudget(memoryBudget),
+		m_residentSize(0),
+		m_useCounter(0),
+		m_numStreamInRequests(0),
+		m_numHits(0),
+		m_numRejectedRequests(0),
+		m_numEvictions(0),
+		m_isStopping(false),
+		m_numReads(0),
+		m_numFailedReads(0),
+		m_bytesRead(0),
+		m_totalReadLatency(0.0),
+		m_maxReadLatency(0.0)
+	{
+		m_worker = std::thread(&DatabaseFileStreamer::workerLoop, this);
+	}
+
+	DatabaseFileStreamer* DatabaseFileStreamer::open(const char* path, uint64_t memoryBudget)
+	{
+		std::FILE* file = std::fopen(path, "rb");
+		if (file == nullptr)
+			return nullptr;
+		return new DatabaseFileStreamer(file, memoryBudget);
+	}
+
+	DatabaseFileStreamer::~DatabaseFileStreamer()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_isStopping = true;
+		}
+		m_readQueued.notify_all();
+		m_worker.join();
+		std::fclose(m_file);
+	}
+
+	void DatabaseFileStreamer::registerContext(DatabaseRuntime& runtime)
+	{
+		runtime.fileStreamer = this;
+		m_contexts.push_back(&runtime);
+	}
+
+	void DatabaseFileStreamer::unregisterContext(DatabaseRuntime& runtime)
+	{
+		DatabaseFileTierStreamer& mediumTier = getTierStreamer(runtime, quality_tier::medium_importance);
+		DatabaseFileTierStreamer& lowTier = getTierStreamer(runtime, quality_tier::lowest_importance);
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_readCompleted.wait(lock, [&]() { return mediumTier.m_numPendingReads == 0 && lowTier.m_numPendingReads == 0; });
+		}
+		m_contexts.erase(std::remove(m_contexts.begin(), m_contexts.end(), &runtime), m_contexts.end());
+	}
+
+	bool DatabaseFileStreamer::beginStreamIn(DatabaseRuntime& runtime, quality_tier tier)
+	{
+		runtime.lastStreamInRequest = ++m_useCounter;
+		m_numStreamInRequests++;
+		if (runtime.context.is_streamed_in(tier))
+		{
+			m_numHits++;
+			return true;
+		}
+
+		DatabaseFileTierStreamer& tierStreamer = getTierStreamer(runtime, tier);
+		reclaimFailedTier(tierStreamer);
+		if (tierStreamer.isReserved())
+			return true;
+		if (!reserve(runtime, tierStreamer.getSizeInBytes()))
+		{
+			m_numRejectedRequests++;
+			return false;
+		}
+		tierStreamer.setReserved(true);
+		return true;
+	}
+
+	void DatabaseFileStreamer::endStreamIn(DatabaseRuntime& runtime, quality_tier tier)
+	{
+		DatabaseFileTierStreamer& tierStreamer = getTierStreamer(runtime, tier);
+		if (tierStreamer.isReserved() && tierStreamer.get_bulk_data() == nullptr)
+		{
+			release(tierStreamer.getSizeInBytes());
+			tierStreamer.setReserved(false);
+		}
+	}
+
+	void DatabaseFileStreamer::getStatistics(DatabaseStreamingStatistics& outStatistics)
+	{
+		outStatistics.numStreamInRequests = m_numStreamInRequests;
+		outStatistics.numHits             = m_numHits;
+		outStatistics.numRejectedRequests = m_numRejectedRequests;
+		outStatistics.numEvictions        = m_numEvictions;
+		outStatistics.residentSizeInBytes = static_cast<long long>(m_residentSize);
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		outStatistics.numReads                         = m_numReads;
+		outStatistics.numFailedReads                   = m_numFailedReads;
+		outStatistics.bytesRead                        = static_cast<long long>(m_bytesRead);
+		outStatistics.averageReadLatencyInMilliseconds = m_numReads == 0 ? 0.f : static_cast<float>(m_totalReadLatency * 1000.0 / m_numReads);
+		outStatistics.maxReadLatencyInMilliseconds     = static_cast<float>(m_maxReadLatency * 1000.0);
+	}
+
+	void DatabaseFileStreamer::enqueueRead(DatabaseFileTierStreamer& tierStreamer, uint32_t offset, uint32_t size, const std::function<void(bool)>& continuation)
+	{
+		ReadRequest request;
+		request.destination  = tierStreamer.m_bulkData + offset;
+		request.fileOffset   = tierStreamer.m_fileOffset + offset;
+		request.sizeInBytes  = size;
+		request.continuation = continuation;
+		request.tierStreamer = &tierStreamer;
+		request.queuedTime   = Clock::now();
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			tierStreamer.m_numPendingReads++;
+			m_reads.push_back(std::move(request));
+		}
+		m_readQueued.notify_one();
+	}
+
+	void DatabaseFileStreamer::release(uint32_t sizeInBytes)
+	{
+		m_residentSize -= sizeInBytes;
+	}
+
+	bool DatabaseFileStreamer::reserve(const DatabaseRuntime& requester, uint32_t sizeInBytes)
+	{
+		if (m_memoryBudget != 0)
+		{
+			if (sizeInBytes > m_memoryBudget)
+				return false;
+			while (m_residentSize + sizeInBytes > m_memoryBudget)
+			{
+				if (!evictLeastRecentlyUsed(requester))
+					return false;
+			}
+		}
+		m_residentSize += sizeInBytes;
+		return true;
+	}
+
+	// ACL considers none of the chunks of a tier whose every read failed to be streamed in, so it never streams that tier out.
+	// Such tiers are freed here instead, on the thread making stream requests, since that thread also allocates them.
+	bool DatabaseFileStreamer::reclaimFailedTier(DatabaseFileTierStreamer& tierStreamer)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (tierStreamer.m_bulkData == nullptr || tierStreamer.m_numPendingReads != 0 || tierStreamer.m_numLoadedReads != 0)
+				return false;
+		}
+
+		tierStreamer.m_allocator.deallocate(tierStreamer.m_bulkData, tierStreamer.m_sizeInBytes);
+		tierStreamer.m_bulkData = nullptr;
+		if (tierStreamer.isReserved())
+		{
+			release(tierStreamer.getSizeInBytes());
+			tierStreamer.setReserved(false);
+		}
+		return true;
+	}
+
+	bool DatabaseFileStreamer::reclaimFailedTiers()
+	{
+		bool isReclaimed = false;
+		for (DatabaseRuntime* runtime : m_contexts)
+		{
+			isReclaimed |= reclaimFailedTier(getTierStreamer(*runtime, quality_tier::medium_importance));
+			isReclaimed |= reclaimFailedTier(getTierStreamer(*runtime, quality_tier::lowest_importance));
+		}
+		return isReclaimed;
+	}
+
+	// Streams out one tier of the least recently requested context, low importance first since it matters least.
+	// Tiers with reads in flight and the tiers of the requesting context are never evicted.
+	bool DatabaseFileStreamer::evictLeastRecentlyUsed(const DatabaseRuntime& requester)
+	{
+		// Tiers which hold no data are always given up before any useful tier
+		if (reclaimFailedTiers())
+			return true;
+
+		DatabaseRuntime* victim = nullptr;
+		quality_tier victimTier = quality_tier::lowest_importance;
+		for (DatabaseRuntime* runtime : m_contexts)
+		{
+			if (runtime == &requester || (victim != nullptr && runtime->lastStreamInRequest >= victim->lastStreamInRequest))
+				continue;
+
+			if (isEvictable(*runtime, quality_tier::lowest_importance))
+			{
+				victim     = runtime;
+				victimTier = quality_tier::lowest_importance;
+			}
+			else if (isEvictable(*runtime, quality_tier::medium_importance))
+			{
+				victim     = runtime;
+				victimTier = quality_tier::medium_importance;
+			}
+		}
+
+		if (victim == nullptr)
+			return false;
+
+		const uint64_t residentSize = m_residentSize;
+		victim->context.stream_out(victimTier);
+		m_numEvictions++;
+		// Guards against looping forever should ACL keep the tier allocated
+		return m_residentSize < residentSize;
+	}
+
+	bool DatabaseFileStreamer::readFile(uint64_t fileOffset, uint8_t* destination, uint32_t sizeInBytes)
+	{
+#if defined(_WIN32)
+		if (_fseeki64(m_file, static_cast<long long>(fileOffset), SEEK_SET) != 0)
+			return false;
+		return std::fread(destination, 1, sizeInBytes, m_file) == sizeInBytes;
+#elif defined(__ANDROID__)
+		// The file is never read through stdio, so bypassing its buffer is safe
+		const int fd = fileno(m_file);
+		while (sizeInBytes > 0)
+		{
+			const ssize_t numRead = pread64(fd, destination, sizeInBytes, static_cast<off64_t>(fileOffset));
+			if (numRead <= 0)
+				return false;
+			destination += numRead;
+			fileOffset  += static_cast<uint64_t>(numRead);
+			sizeInBytes -= static_cast<uint32_t>(numRead);
+		}
+		return true;
+#else
+		if (fseeko(m_file, static_cast<off_t>(fileOffset), SEEK_SET) != 0)
+			return false;
+		return std::fread(destination, 1, sizeInBytes, m_file) == sizeInBytes;
+#endif
+	}
+
+	// Reads are served in order on this thread alone, so the file position needs no synchronization
+	void DatabaseFileStreamer::workerLoop()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (;;)
+		{
+			m_readQueued.wait(lock, [this]() { return m_isStopping || !m_reads.empty(); });
+			if (m_reads.empty())
+				return;
+
+			ReadRequest request = std::move(m_reads.front());
+			m_reads.pop_front();
+			lock.unlock();
+
+			const bool succeeded = readFile(request.fileOffset, request.destination, request.sizeInBytes);
+			request.continuation(succeeded);
+			const double latency = std::chrono::duration<double>(Clock::now() - request.queuedTime).count();
+
+			lock.lock();
+			m_numReads++;
+			if (succeeded)
+			{
+				m_bytesRead += request.sizeInBytes;
+				request.tierStreamer->m_numLoadedReads++;
+			}
+			else
+				m_numFailedReads++;
+			m_totalReadLatency += latency;
+			m_maxReadLatency = std::max(m_maxReadLatency, latency);
+			request.tierStreamer->m_numPendingReads--;
+			m_readCompleted.notify_all();
+		}
+	}
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "database.h"
+
+#include "acl/core/iallocator.h"
+#include "acl/decompression/database/idatabase_streamer.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AclUnity
+{
+	struct DatabaseRuntime;
+	class DatabaseFileStreamer;
+
+	/// Streams one tier of one database from a range of the file owned by a DatabaseFileStreamer.
+	/// The whole tier is allocated when its first chunk streams in and released when its last chunk streams out.
+	/// A tier whose every read failed is released by the next stream request for it, or when another tier needs room in the budget.
+	class DatabaseFileTierStreamer final : public acl::idatabase_streamer
+	{
+	public:
+		DatabaseFileTierStreamer(DatabaseFileStreamer& fileStreamer, acl::iallocator& allocator, uint64_t fileOffset, uint32_t sizeInBytes);
+		virtual ~DatabaseFileTierStreamer() override;
+
+		virtual bool is_initialized() const override { return true; }
+		virtual const uint8_t* get_bulk_data() const override { return m_bulkData; }
+		virtual void stream_in(uint32_t offset, uint32_t size, bool can_allocate_bulk_data, const std::function<void(bool success)>& continuation) override;
+		virtual void stream_out(uint32_t offset, uint32_t size, bool can_deallocate_bulk_data, const std::function<void(bool success)>& continuation) override;
+
+		uint32_t getSizeInBytes() const { return m_sizeInBytes; }
+
+		/// Whether the tier's size is currently counted against the memory budget.
+		bool isReserved() const { return m_isReserved; }
+		void setReserved(bool isReserved) { m_isReserved = isReserved; }
+
+	private:
+		friend class DatabaseFileStreamer;
+
+		DatabaseFileStreamer& m_fileStreamer;
+		acl::iallocator&      m_allocator;
+		uint64_t              m_fileOffset;
+		uint32_t              m_sizeInBytes;
+		uint8_t*              m_bulkData;
+		bool                  m_isReserved;
+		// Guarded by the file streamer's mutex
+		int                   m_numPendingReads;
+		int                   m_numLoadedReads;
+	};
+
+	/// Reads database tiers from a single file on a dedicated worker thread and keeps the tiers of every context
+	/// streaming from it within one memory budget, evicting the tiers of the least recently requested context first.
+	/// Stream requests for all of its contexts must come from one thread at a time. Reads complete on the worker thread.
+	class DatabaseFileStreamer
+	{
+	public:
+		/// Opens the file from this translation unit, which is built with 64-bit file offsets. A memoryBudget of 0 disables the budget.
+		/// Returns nullptr if the file could not be opened.
+		static DatabaseFileStreamer* open(const char* path, uint64_t memoryBudget);
+		~DatabaseFileStreamer();
+
+		void registerContext(DatabaseRuntime& runtime);
+
+		/// Waits for every read into the context's tiers to finish, then forgets the context.
+		void unregisterContext(DatabaseRuntime& runtime);
+
+		/// Called before a stream-in request reaches ACL. Records the request and reserves the tier within the budget,
+		/// evicting other tiers as needed. Returns false if the tier cannot fit.
+		bool beginStreamIn(DatabaseRuntime& runtime, acl::quality_tier tier);
+
+		/// Called after a stream-in request has been given to ACL. Releases the reservation if ACL did not allocate the tier.
+		void endStreamIn(DatabaseRuntime& runtime, acl::quality_tier tier);
+
+		void getStatistics(DatabaseStreamingStatistics& outStatistics);
+
+	private:
+		friend class DatabaseFileTierStreamer;
+
+		typedef std::chrono::steady_clock Clock;
+
+		struct ReadRequest
+		{
+			uint8_t*                  destination;
+			uint64_t                  fileOffset;
+			uint32_t                  sizeInBytes;
+			std::function<void(bool)> continuation;
+			DatabaseFileTierStreamer* tierStreamer;
+			Clock::time_point         queuedTime;
+		};
+
+		/// Takes ownership of the file
+		DatabaseFileStreamer(std::FILE* file, uint64_t memoryBudget);
+		DatabaseFileStreamer(const DatabaseFileStreamer&) = delete;
+		DatabaseFileStreamer& operator=(const DatabaseFileStreamer&) = delete;
+
+		void enqueueRead(DatabaseFileTierStreamer& tierStreamer, uint32_t offset, uint32_t size, const std::function<void(bool)>& continuation);
+		void release(uint32_t sizeInBytes);
+		bool reserve(const DatabaseRuntime& requester, uint32_t sizeInBytes);
+		bool reclaimFailedTier(DatabaseFileTierStreamer& tierStreamer);
+		bool reclaimFailedTiers();
+		bool evictLeastRecentlyUsed(const DatabaseRuntime& requester);
+		bool readFile(uint64_t fileOffset, uint8_t* destination, uint32_t sizeInBytes);
+		void workerLoop();
+
+		std::FILE*                    m_file;
+		uint64_t                      m_memoryBudget;
+		std::atomic<uint64_t>         m_residentSize;
+		uint64_t                      m_useCounter;
+		std::vector<DatabaseRuntime*> m_contexts;
+
+		std::atomic<int>              m_numStreamInRequests;
+		std::atomic<int>              m_numHits;
+		std::atomic<int>              m_numRejectedRequests;
+		std::atomic<int>              m_numEvictions;
+
+		// Guards everything below
+		std::mutex                    m_mutex;
+		std::condition_variable       m_readQueued;
+		std::condition_variable       m_readCompleted;
+		std::deque<ReadRequest>       m_reads;
+		bool                          m_isStopping;
+		int                           m_numReads;
+		int                           m_numFailedReads;
+		uint64_t                      m_bytesRead;
+		double                        m_totalReadLatency;
+		double                        m_maxReadLatency;
+
+		std::thread                   m_worker;
+	};
+}
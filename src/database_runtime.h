@@ -0,0 +1,30 @@
+#pragma once
+
+#include "decompression_settings.h"
+
+#include "acl/core/ansi_allocator.h"
+#include "acl/decompression/database/idatabase_streamer.h"
+
+#include <cstdint>
+#include <memory>
+
+namespace AclUnity
+{
+	class DatabaseFileStreamer;
+
+	// Everything behind a handle returned by createDatabaseContext or createFileDatabaseContext.
+	// The context is declared last so that it is destroyed before the streamers it references.
+	struct DatabaseRuntime
+	{
+		acl::ansi_allocator                      allocator;
+		std::unique_ptr<acl::idatabase_streamer> mediumTierStreamer;
+		std::unique_ptr<acl::idatabase_streamer> lowTierStreamer;
+		// Set when the tiers stream from a file, whose memory budget is shared with every other context streaming from it
+		DatabaseFileStreamer*                    fileStreamer;
+		// When the tiers were last requested, used by the file streamer to evict the least recently requested context first
+		uint64_t                                 lastStreamInRequest;
+		DatabaseContext                          context;
+
+		DatabaseRuntime() : fileStreamer(nullptr), lastStreamInRequest(0) {}
+	};
+}
@@ -1,8 +1,21 @@
 #include "decompression.h"
 
-#include "acl/decompression/decompress.h"
+#include "decompression_settings.h"
+#include "database_runtime.h"
+#include "acl/core/memory_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <vector>
 
 using namespace acl;
+using AclUnity::TransformDecompressionContext;
+using AclUnity::FloatDecompressionContext;
+using AclUnity::DatabaseTransformDecompressionContext;
+using AclUnity::DatabaseRuntime;
 
 namespace 
 {
@@ -134,6 +147,37 @@ namespace
 		bool skip_track_scale(uint32_t track_index) const { return (m_mask[track_index >> 6] & (1ull << (track_index & 0x3f))) == 0; }
 	};
 
+	// Stripped default sub-tracks take their value from the default pose the clip was compressed with
+	template<typename PoseWriter>
+	class DefaultPoseTrackWriter : public PoseWriter
+	{
+	private:
+		const float* m_defaultPose;
+
+	public:
+		template<typename... Args>
+		DefaultPoseTrackWriter(const float* defaultPose, Args... args) : PoseWriter(args...), m_defaultPose(defaultPose) {}
+
+		static constexpr default_sub_track_mode get_rotation_default_mode() { return default_sub_track_mode::variable; }
+		static constexpr default_sub_track_mode get_translation_default_mode() { return default_sub_track_mode::variable; }
+		static constexpr default_sub_track_mode get_scale_default_mode() { return default_sub_track_mode::variable; }
+
+		rtm::quatf RTM_SIMD_CALL get_variable_default_rotation(uint32_t track_index) const { return rtm::quat_load(m_defaultPose + 12 * track_index); }
+		rtm::vector4f RTM_SIMD_CALL get_variable_default_translation(uint32_t track_index) const { return rtm::vector_load(m_defaultPose + 12 * track_index + 4); }
+		rtm::vector4f RTM_SIMD_CALL get_variable_default_scale(uint32_t track_index) const { return rtm::vector_load(m_defaultPose + 12 * track_index + 8); }
+	};
+
+	// Stripped default sub-tracks are never written, leaving the default pose the caller initialized the buffer with
+	class PoseSkipDefaultsTrackWriter : public PoseTrackWriter
+	{
+	public:
+		PoseSkipDefaultsTrackWriter(float* outputBuffer) : PoseTrackWriter(outputBuffer) {}
+
+		static constexpr default_sub_track_mode get_rotation_default_mode() { return default_sub_track_mode::skipped; }
+		static constexpr default_sub_track_mode get_translation_default_mode() { return default_sub_track_mode::skipped; }
+		static constexpr default_sub_track_mode get_scale_default_mode() { return default_sub_track_mode::skipped; }
+	};
+
 	class UniformScaleTrackWriter : public track_writer
 	{
 	private:
@@ -391,37 +435,219 @@ namespace
 		}
 	};
 
-	class TransformDecompressionSettings : public default_transform_decompression_settings
+	// Samples a pose from an initialized transform context of any decompression settings, such as one bound to a database
+	template<typename TransformContext, typename PoseWriter, typename ScaleWriter>
+	void decompressPose(TransformContext& context, const void* compressedScaleTracks, PoseWriter& writer, ScaleWriter& scaleWriter, float time, unsigned char keyframeInterpolationMode)
 	{
-	public:
-		// We perform these safety checks at the C# layer.
-		// The most important check is ensuring that the compressed tracks object is aligned to a 16 byte boundary.
-		// This will require custom offsets when working with BlobAssets.
-		static constexpr bool skip_initialize_safety_checks() { return true; }
+		context.seek(time, static_cast<sample_rounding_policy>(keyframeInterpolationMode));
+		if (compressedScaleTracks == nullptr)
+			context.decompress_tracks(writer);
+		else
+		{
+			FloatDecompressionContext scaleContext;
+			scaleContext.initialize(*static_cast<const compressed_tracks*>(compressedScaleTracks));
+			context.decompress_tracks(writer);
+			scaleContext.seek(time, static_cast<sample_rounding_policy>(keyframeInterpolationMode));
+			scaleContext.decompress_tracks(scaleWriter);
+		}
+	}
+
+	// Shared by the samplers which differ from samplePose only in their writers
+	template<typename PoseWriter, typename ScaleWriter>
+	void decompressPose(const void* compressedTransformTracks, const void* compressedScaleTracks, PoseWriter& writer, ScaleWriter& scaleWriter, float time, unsigned char keyframeInterpolationMode)
+	{
+		TransformDecompressionContext context;
+		context.initialize(*static_cast<const compressed_tracks*>(compressedTransformTracks));
+		decompressPose(context, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+	}
+
+	const uint32_t kClipInitCacheTag = 0x43494341;	// 'ACIC'
 
-		// Force the version to the tagged 2.1 to decrease code size.
-		static constexpr compressed_tracks_version16 version_supported() { return compressed_tracks_version16::v02_01_00; }
+	// Decompression contexts initialized once in caller memory, since initialize() parses the whole clip header.
+	// ACL contexts cannot be copied, so there is no immutable part to share between instances and seek a stack copy of:
+	// samplers seek the cached contexts in place, which makes each cache per-instance, single-threaded state.
+	struct ClipInitCache
+	{
+		TransformDecompressionContext transformContext;
+		FloatDecompressionContext     scaleContext;
+		uint32_t                      tag;
+		bool                          hasScaleContext;
 	};
 
-	using TransformDecompressionContext = decompression_context<TransformDecompressionSettings>;
+	// Returns nullptr if the cache was not built by buildClipInitCache or was built for a clip with different parts
+	ClipInitCache* getClipInitCache(void* initCache, const void* compressedScaleTracks)
+	{
+		ClipInitCache* cache = static_cast<ClipInitCache*>(initCache);
+		if (cache->tag != kClipInitCacheTag || cache->hasScaleContext != (compressedScaleTracks != nullptr))
+			return nullptr;
+		return cache;
+	}
+
+	// The clip may have moved since the cache was built, which only requires patching the cached pointers.
+	// A context which cannot be relocated onto the tracks is initialized again.
+	template<typename Context>
+	void bindCachedContext(Context& context, const void* compressedTracks)
+	{
+		const compressed_tracks& tracks = *static_cast<const compressed_tracks*>(compressedTracks);
+		if (context.get_compressed_tracks() != &tracks && !context.relocated(tracks))
+			context.initialize(tracks);
+	}
 
-	class FloatDecompressionSettings : public decompression_settings
+	template<typename PoseWriter, typename ScaleWriter>
+	int decompressPoseFromInitCache(void*          initCache,
+									const void*    compressedTransformTracks,
+									const void*    compressedScaleTracks,
+									PoseWriter&    writer,
+									ScaleWriter&   scaleWriter,
+									float          time,
+									unsigned char  keyframeInterpolationMode)
 	{
-	public:
-		// We perform these safety checks at the C# layer.
-		// The most important check is ensuring that the compressed tracks object is aligned to a 16 byte boundary.
-		static constexpr bool skip_initialize_safety_checks() { return true; }
+		ClipInitCache* cache = getClipInitCache(initCache, compressedScaleTracks);
+		if (cache == nullptr)
+			return 0;
+
+		bindCachedContext(cache->transformContext, compressedTransformTracks);
+		cache->transformContext.seek(time, static_cast<sample_rounding_policy>(keyframeInterpolationMode));
+		if (compressedScaleTracks == nullptr)
+			cache->transformContext.decompress_tracks(writer);
+		else
+		{
+			bindCachedContext(cache->scaleContext, compressedScaleTracks);
+			cache->transformContext.decompress_tracks(writer);
+			cache->scaleContext.seek(time, static_cast<sample_rounding_policy>(keyframeInterpolationMode));
+			cache->scaleContext.decompress_tracks(scaleWriter);
+		}
+		return 1;
+	}
+
+	struct CompressedClipParts
+	{
+		const void*  transformTracks;
+		const void*  scaleTracks;
+		const void*  scalarTracks;
+		const float* staticPose;
+		const float* defaultPose;
+		int          numBones;
+	};
+
+	// Locates the parts of a combined clip. The parts about to be sampled are prefetched together up front
+	// so that their headers load in parallel rather than each waiting on the previous context.
+	// Returns false if the clip has an unknown header layout, in which case nothing is located.
+	bool getCompressedClipParts(const void* compressedClip, bool includePose, bool includeCurves, CompressedClipParts& outParts)
+	{
+		const CompressedClipHeader* header = static_cast<const CompressedClipHeader*>(compressedClip);
+		if (header->layoutTag != ACL_UNITY_COMPRESSED_CLIP_LAYOUT_TAG)
+			return false;
+		const uint8_t* base = static_cast<const uint8_t*>(compressedClip);
+
+		outParts.transformTracks = base + header->transformTracksOffset;
+		outParts.scaleTracks     = header->scaleTracksOffset == 0 ? nullptr : base + header->scaleTracksOffset;
+		outParts.scalarTracks    = header->scalarTracksOffset == 0 ? nullptr : base + header->scalarTracksOffset;
+		outParts.staticPose      = header->staticPoseOffset == 0 ? nullptr : reinterpret_cast<const float*>(base + header->staticPoseOffset);
+		outParts.defaultPose     = header->defaultPoseOffset == 0 ? nullptr : reinterpret_cast<const float*>(base + header->defaultPoseOffset);
+		outParts.numBones        = header->numBones;
+
+		if (includePose && outParts.staticPose != nullptr)
+			memory_prefetch(outParts.staticPose);
+		else if (includePose)
+		{
+			memory_prefetch(outParts.transformTracks);
+			if (outParts.scaleTracks != nullptr)
+				memory_prefetch(outParts.scaleTracks);
+		}
+		if (includeCurves && outParts.scalarTracks != nullptr)
+			memory_prefetch(outParts.scalarTracks);
+		return true;
+	}
 
-		static constexpr bool is_track_type_supported(track_type8 type) { return type == track_type8::float1f; }
+	// The static pose holds exactly what PoseTrackWriter and UniformScaleTrackWriter produce, so blending it with the same math
+	// as the blending writers matches the regular path without seeking or unpacking any bits. Shared poses in batches do the same.
+	void copyPose(const float* pose, int numBones, float* outputBuffer)
+	{
+		std::memcpy(outputBuffer, pose, static_cast<size_t>(numBones) * 12 * sizeof(float));
+	}
+
+	void blendPoseFirst(const float* pose, int numBones, float* outputBuffer, float blendFactor)
+	{
+		const rtm::vector4f blend = rtm::vector_broadcast(&blendFactor);
+		for (int i = 0; i < numBones; i++)
+		{
+			const float* src = pose + 12 * i;
+			float* dst = outputBuffer + 12 * i;
+			rtm::vector_store(rtm::vector_mul(rtm::vector_load(src), blend), dst);
+			rtm::vector_store(rtm::vector_mul(rtm::vector_set_w(rtm::vector_load(src + 4), 1.f), blend), dst + 4);
+			rtm::vector_store(rtm::vector_mul(rtm::vector_load(src + 8), blend), dst + 8);
+		}
+	}
+
+	void blendPoseAdd(const float* pose, int numBones, float* outputBuffer, float blendFactor)
+	{
+		const rtm::vector4f blend = rtm::vector_broadcast(&blendFactor);
+		for (int i = 0; i < numBones; i++)
+		{
+			const float* src = pose + 12 * i;
+			float* dst = outputBuffer + 12 * i;
+			const rtm::vector4f prevRot = rtm::vector_load(dst);
+			rtm::vector4f newRot = rtm::vector_load(src);
+			newRot = rtm::vector_dot(prevRot, newRot) < 0.0f ? rtm::vector_neg(newRot) : newRot;
+			rtm::vector_store(rtm::vector_mul_add(newRot, blend, prevRot), dst);
+			rtm::vector_store(rtm::vector_mul_add(rtm::vector_set_w(rtm::vector_load(src + 4), 1.f), blend, rtm::vector_load(dst + 4)), dst + 4);
+			rtm::vector_store(rtm::vector_mul_add(rtm::vector_load(src + 8), blend, rtm::vector_load(dst + 8)), dst + 8);
+		}
+	}
+
+	// Two batch requests share a key only when they sample the same clip with the same mode at the same time, bit for bit.
+	// Nearby times which round to the same keyframe are not merged, since that would mean duplicating how seek() resolves
+	// keyframes, including clamping, looping, and stripped keyframes.
+	struct PoseSampleKey
+	{
+		const void* transformTracks;
+		const void* scaleTracks;
+		uint32_t    timeBits;
+		uint8_t     mode;
 
-		// Force the version to the tagged 2.1 to decrease code size.
-		static constexpr compressed_tracks_version16 version_supported() { return compressed_tracks_version16::v02_01_00; }
+		bool operator<(const PoseSampleKey& other) const
+		{
+			if (transformTracks != other.transformTracks)
+				return transformTracks < other.transformTracks;
+			if (scaleTracks != other.scaleTracks)
+				return scaleTracks < other.scaleTracks;
+			if (mode != other.mode)
+				return mode < other.mode;
+			return timeBits < other.timeBits;
+		}
 
-		// Todo: Make a separate variant for this when a user requests this feature.
-		static constexpr bool is_per_track_rounding_supported() { return false; }
+		bool operator==(const PoseSampleKey& other) const
+		{
+			return !(*this < other) && !(other < *this);
+		}
 	};
 
-	using FloatDecompressionContext = decompression_context<FloatDecompressionSettings>;
+	PoseSampleKey makePoseSampleKey(const PoseSampleRequest& request)
+	{
+		PoseSampleKey key;
+		key.transformTracks = request.compressedTransformTracks;
+		key.scaleTracks     = request.compressedScaleTracks;
+		key.mode            = request.keyframeInterpolationMode;
+		std::memcpy(&key.timeBits, &request.time, sizeof(float));
+		return key;
+	}
+
+	void sampleBatchRequest(const PoseSampleRequest& request)
+	{
+		switch (request.blendMode)
+		{
+		case 1:
+			samplePoseBlendedFirst(request.compressedTransformTracks, request.compressedScaleTracks, request.aosOutputBuffer, request.blendFactor, request.time, request.keyframeInterpolationMode);
+			break;
+		case 2:
+			samplePoseBlendedAdd(request.compressedTransformTracks, request.compressedScaleTracks, request.aosOutputBuffer, request.blendFactor, request.time, request.keyframeInterpolationMode);
+			break;
+		default:
+			samplePose(request.compressedTransformTracks, request.compressedScaleTracks, request.aosOutputBuffer, request.time, request.keyframeInterpolationMode);
+			break;
+		}
+	}
 }
 
 // It is advantageous to perform as much trivial work between seek() and decompress_track[s]() because seek() prefetches.
@@ -640,3 +866,272 @@ ACL_UNITY_API float sampleFloat(const void* compressedFloatTracks, int trackInde
 	context.decompress_track(uindex, writer);
 	return result;
 }
+
+ACL_UNITY_API void samplePoseFromClip(const void* compressedClip, float* aosOutputBuffer, float time, unsigned char keyframeInterpolationMode)
+{
+	CompressedClipParts parts;
+	if (!getCompressedClipParts(compressedClip, true, false, parts))
+		return;
+	if (parts.staticPose != nullptr)
+		copyPose(parts.staticPose, parts.numBones, aosOutputBuffer);
+	else if (parts.defaultPose != nullptr)
+		samplePoseWithDefaults(parts.transformTracks, parts.scaleTracks, parts.defaultPose, aosOutputBuffer, time, keyframeInterpolationMode);
+	else
+		samplePose(parts.transformTracks, parts.scaleTracks, aosOutputBuffer, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseFromClipBlendedFirst(const void* compressedClip, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode)
+{
+	CompressedClipParts parts;
+	if (!getCompressedClipParts(compressedClip, true, false, parts))
+		return;
+	if (parts.staticPose != nullptr)
+		blendPoseFirst(parts.staticPose, parts.numBones, aosOutputBuffer, blendFactor);
+	else if (parts.defaultPose != nullptr)
+		samplePoseWithDefaultsBlendedFirst(parts.transformTracks, parts.scaleTracks, parts.defaultPose, aosOutputBuffer, blendFactor, time, keyframeInterpolationMode);
+	else
+		samplePoseBlendedFirst(parts.transformTracks, parts.scaleTracks, aosOutputBuffer, blendFactor, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseFromClipBlendedAdd(const void* compressedClip, float* aosOutputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode)
+{
+	CompressedClipParts parts;
+	if (!getCompressedClipParts(compressedClip, true, false, parts))
+		return;
+	if (parts.staticPose != nullptr)
+		blendPoseAdd(parts.staticPose, parts.numBones, aosOutputBuffer, blendFactor);
+	else if (parts.defaultPose != nullptr)
+		samplePoseWithDefaultsBlendedAdd(parts.transformTracks, parts.scaleTracks, parts.defaultPose, aosOutputBuffer, blendFactor, time, keyframeInterpolationMode);
+	else
+		samplePoseBlendedAdd(parts.transformTracks, parts.scaleTracks, aosOutputBuffer, blendFactor, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void sampleCurvesFromClip(const void* compressedClip, float* floatOutputBuffer, float time, unsigned char keyframeInterpolationMode)
+{
+	CompressedClipParts parts;
+	if (!getCompressedClipParts(compressedClip, false, true, parts))
+		return;
+	if (parts.scalarTracks != nullptr)
+		sampleFloats(parts.scalarTracks, floatOutputBuffer, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseAndCurvesFromClip(const void* compressedClip, float* aosOutputBuffer, float* floatOutputBuffer, float time, unsigned char keyframeInterpolationMode)
+{
+	CompressedClipParts parts;
+	if (!getCompressedClipParts(compressedClip, true, true, parts))
+		return;
+	if (parts.staticPose != nullptr)
+		copyPose(parts.staticPose, parts.numBones, aosOutputBuffer);
+	else if (parts.defaultPose != nullptr)
+		samplePoseWithDefaults(parts.transformTracks, parts.scaleTracks, parts.defaultPose, aosOutputBuffer, time, keyframeInterpolationMode);
+	else
+		samplePose(parts.transformTracks, parts.scaleTracks, aosOutputBuffer, time, keyframeInterpolationMode);
+	if (parts.scalarTracks != nullptr)
+		sampleFloats(parts.scalarTracks, floatOutputBuffer, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseWithDatabase(const void* databaseContext, const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, float time, unsigned char keyframeInterpolationMode)
+{
+	DatabaseTransformDecompressionContext context;
+	context.initialize(*static_cast<const compressed_tracks*>(compressedTransformTracks), static_cast<const DatabaseRuntime*>(databaseContext)->context);
+	PoseTrackWriter writer(outputBuffer);
+	UniformScaleTrackWriter scaleWriter(outputBuffer);
+	decompressPose(context, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseWithDatabaseBlendedFirst(const void* databaseContext, const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode)
+{
+	DatabaseTransformDecompressionContext context;
+	context.initialize(*static_cast<const compressed_tracks*>(compressedTransformTracks), static_cast<const DatabaseRuntime*>(databaseContext)->context);
+	PoseBlendedFirstTrackWriter writer(outputBuffer, blendFactor);
+	UniformScaleBlendedFirstTrackWriter scaleWriter(outputBuffer, blendFactor);
+	decompressPose(context, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseWithDatabaseBlendedAdd(const void* databaseContext, const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode)
+{
+	DatabaseTransformDecompressionContext context;
+	context.initialize(*static_cast<const compressed_tracks*>(compressedTransformTracks), static_cast<const DatabaseRuntime*>(databaseContext)->context);
+	PoseBlendedAddTrackWriter writer(outputBuffer, blendFactor, compressedScaleTracks == nullptr ? 1.f : 0.f);
+	UniformScaleBlendedAddTrackWriter scaleWriter(outputBuffer, blendFactor);
+	decompressPose(context, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseWithDefaults(const void* compressedTransformTracks, const void* compressedScaleTracks, const float* defaultPose, float* outputBuffer, float time, unsigned char keyframeInterpolationMode)
+{
+	DefaultPoseTrackWriter<PoseTrackWriter> writer(defaultPose, outputBuffer);
+	UniformScaleTrackWriter scaleWriter(outputBuffer);
+	decompressPose(compressedTransformTracks, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseWithDefaultsBlendedFirst(const void* compressedTransformTracks, const void* compressedScaleTracks, const float* defaultPose, float* outputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode)
+{
+	DefaultPoseTrackWriter<PoseBlendedFirstTrackWriter> writer(defaultPose, outputBuffer, blendFactor);
+	UniformScaleBlendedFirstTrackWriter scaleWriter(outputBuffer, blendFactor);
+	decompressPose(compressedTransformTracks, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseWithDefaultsBlendedAdd(const void* compressedTransformTracks, const void* compressedScaleTracks, const float* defaultPose, float* outputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode)
+{
+	DefaultPoseTrackWriter<PoseBlendedAddTrackWriter> writer(defaultPose, outputBuffer, blendFactor, compressedScaleTracks == nullptr ? 1.f : 0.f);
+	UniformScaleBlendedAddTrackWriter scaleWriter(outputBuffer, blendFactor);
+	decompressPose(compressedTransformTracks, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void samplePoseSkipDefaults(const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, float time, unsigned char keyframeInterpolationMode)
+{
+	PoseSkipDefaultsTrackWriter writer(outputBuffer);
+	UniformScaleTrackWriter scaleWriter(outputBuffer);
+	decompressPose(compressedTransformTracks, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API int getClipInitCacheSize()
+{
+	return static_cast<int>(sizeof(ClipInitCache));
+}
+
+ACL_UNITY_API int getClipInitCacheAlignment()
+{
+	return static_cast<int>(alignof(ClipInitCache));
+}
+
+ACL_UNITY_API int buildClipInitCache(const void* compressedTransformTracks, const void* compressedScaleTracks, void* outInitCache)
+{
+	if ((reinterpret_cast<uintptr_t>(outInitCache) & (alignof(ClipInitCache) - 1)) != 0)
+		return 0;
+
+	ClipInitCache* cache = new(outInitCache) ClipInitCache();
+	cache->transformContext.initialize(*static_cast<const compressed_tracks*>(compressedTransformTracks));
+	if (compressedScaleTracks != nullptr)
+		cache->scaleContext.initialize(*static_cast<const compressed_tracks*>(compressedScaleTracks));
+	cache->hasScaleContext = compressedScaleTracks != nullptr;
+	cache->tag             = kClipInitCacheTag;
+	return 1;
+}
+
+ACL_UNITY_API void destroyClipInitCache(void* initCache)
+{
+	ClipInitCache* cache = static_cast<ClipInitCache*>(initCache);
+	cache->~ClipInitCache();
+}
+
+ACL_UNITY_API int samplePoseWithInitCache(void* initCache, const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, float time, unsigned char keyframeInterpolationMode)
+{
+	PoseTrackWriter writer(outputBuffer);
+	UniformScaleTrackWriter scaleWriter(outputBuffer);
+	return decompressPoseFromInitCache(initCache, compressedTransformTracks, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API int samplePoseWithInitCacheBlendedFirst(void* initCache, const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode)
+{
+	PoseBlendedFirstTrackWriter writer(outputBuffer, blendFactor);
+	UniformScaleBlendedFirstTrackWriter scaleWriter(outputBuffer, blendFactor);
+	return decompressPoseFromInitCache(initCache, compressedTransformTracks, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API int samplePoseWithInitCacheBlendedAdd(void* initCache, const void* compressedTransformTracks, const void* compressedScaleTracks, float* outputBuffer, float blendFactor, float time, unsigned char keyframeInterpolationMode)
+{
+	PoseBlendedAddTrackWriter writer(outputBuffer, blendFactor, compressedScaleTracks == nullptr ? 1.f : 0.f);
+	UniformScaleBlendedAddTrackWriter scaleWriter(outputBuffer, blendFactor);
+	return decompressPoseFromInitCache(initCache, compressedTransformTracks, compressedScaleTracks, writer, scaleWriter, time, keyframeInterpolationMode);
+}
+
+ACL_UNITY_API void benchmarkClipInitCache(const void* compressedTransformTracks,
+										  const void* compressedScaleTracks,
+										  int         numSamples,
+										  float*      outInitializeNanoseconds,
+										  float*      outInitCacheNanoseconds)
+{
+	*outInitializeNanoseconds = 0.f;
+	*outInitCacheNanoseconds  = 0.f;
+	if (numSamples <= 0)
+		return;
+
+	const compressed_tracks& tracks = *static_cast<const compressed_tracks*>(compressedTransformTracks);
+	std::vector<float> pose(static_cast<size_t>(tracks.get_num_tracks()) * 12);
+	const float duration = tracks.get_duration();
+	auto timeAt = [&](int sampleIndex) { return numSamples == 1 ? 0.f : duration * static_cast<float>(sampleIndex) / static_cast<float>(numSamples - 1); };
+
+	std::aligned_storage<sizeof(ClipInitCache), alignof(ClipInitCache)>::type storage;
+	buildClipInitCache(compressedTransformTracks, compressedScaleTracks, &storage);
+
+	// The warm-up pass keeps first-touch page faults out of the measurement
+	for (int i = 0; i < numSamples; i++)
+	{
+		samplePose(compressedTransformTracks, compressedScaleTracks, pose.data(), timeAt(i), 0);
+		samplePoseWithInitCache(&storage, compressedTransformTracks, compressedScaleTracks, pose.data(), timeAt(i), 0);
+	}
+
+	typedef std::chrono::steady_clock Clock;
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < numSamples; i++)
+		samplePose(compressedTransformTracks, compressedScaleTracks, pose.data(), timeAt(i), 0);
+	const std::chrono::duration<double, std::nano> initializeElapsed = Clock::now() - start;
+
+	start = Clock::now();
+	for (int i = 0; i < numSamples; i++)
+		samplePoseWithInitCache(&storage, compressedTransformTracks, compressedScaleTracks, pose.data(), timeAt(i), 0);
+	const std::chrono::duration<double, std::nano> initCacheElapsed = Clock::now() - start;
+
+	destroyClipInitCache(&storage);
+	*outInitializeNanoseconds = static_cast<float>(initializeElapsed.count() / numSamples);
+	*outInitCacheNanoseconds  = static_cast<float>(initCacheElapsed.count() / numSamples);
+}
+
+ACL_UNITY_API void samplePoseBatch(const PoseSampleRequest* requests, int numRequests)
+{
+	if (numRequests <= 0)
+		return;
+
+	std::vector<PoseSampleKey> keys(static_cast<size_t>(numRequests));
+	std::vector<uint32_t> order(keys.size());
+	for (int i = 0; i < numRequests; i++)
+	{
+		keys[i]  = makePoseSampleKey(requests[i]);
+		order[i] = static_cast<uint32_t>(i);
+	}
+	std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+	// Each group of duplicates decodes once into a shared pose. Requests still apply in their original order below,
+	// since several of them may blend into the same output buffer.
+	const uint32_t kUnshared = ~0u;
+	std::vector<uint32_t> sharedPoseOffsets(keys.size(), kUnshared);
+	std::vector<float> sharedPoses;
+	for (size_t groupStart = 0; groupStart < order.size();)
+	{
+		size_t groupEnd = groupStart + 1;
+		while (groupEnd < order.size() && keys[order[groupEnd]] == keys[order[groupStart]])
+			groupEnd++;
+
+		if (groupEnd - groupStart > 1)
+		{
+			const PoseSampleRequest& request = requests[order[groupStart]];
+			const uint32_t numBones = static_cast<const compressed_tracks*>(request.compressedTransformTracks)->get_num_tracks();
+			const uint32_t offset = static_cast<uint32_t>(sharedPoses.size());
+			sharedPoses.resize(sharedPoses.size() + numBones * 12);
+			samplePose(request.compressedTransformTracks, request.compressedScaleTracks, sharedPoses.data() + offset, request.time, request.keyframeInterpolationMode);
+			for (size_t i = groupStart; i < groupEnd; i++)
+				sharedPoseOffsets[order[i]] = offset;
+		}
+		groupStart = groupEnd;
+	}
+
+	for (int i = 0; i < numRequests; i++)
+	{
+		const PoseSampleRequest& request = requests[i];
+		if (sharedPoseOffsets[i] == kUnshared)
+		{
+			sampleBatchRequest(request);
+			continue;
+		}
+
+		const float* pose = sharedPoses.data() + sharedPoseOffsets[i];
+		const int numBones = static_cast<int>(static_cast<const compressed_tracks*>(request.compressedTransformTracks)->get_num_tracks());
+		if (request.blendMode == 1)
+			blendPoseFirst(pose, numBones, request.aosOutputBuffer, request.blendFactor);
+		else if (request.blendMode == 2)
+			blendPoseAdd(pose, numBones, request.aosOutputBuffer, request.blendFactor);
+		else
+			copyPose(pose, numBones, request.aosOutputBuffer);
+	}
+}
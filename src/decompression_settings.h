@@ -0,0 +1,50 @@
+#pragma once
+
+#include "acl/decompression/decompress.h"
+#include "acl/decompression/database/database.h"
+
+namespace AclUnity
+{
+	class TransformDecompressionSettings : public acl::default_transform_decompression_settings
+	{
+	public:
+		// We perform these safety checks at the C# layer.
+		// The most important check is ensuring that the compressed tracks object is aligned to a 16 byte boundary.
+		// This will require custom offsets when working with BlobAssets.
+		static constexpr bool skip_initialize_safety_checks() { return true; }
+
+		// Force the version to the tagged 2.1 to decrease code size.
+		static constexpr acl::compressed_tracks_version16 version_supported() { return acl::compressed_tracks_version16::v02_01_00; }
+	};
+
+	using TransformDecompressionContext = acl::decompression_context<TransformDecompressionSettings>;
+
+	using DatabaseContext = acl::database_context<acl::default_database_settings>;
+
+	// Kept separate from TransformDecompressionSettings so that clips without a database do not pay for the tier lookups
+	class DatabaseTransformDecompressionSettings : public TransformDecompressionSettings
+	{
+	public:
+		using database_settings_type = acl::default_database_settings;
+	};
+
+	using DatabaseTransformDecompressionContext = acl::decompression_context<DatabaseTransformDecompressionSettings>;
+
+	class FloatDecompressionSettings : public acl::decompression_settings
+	{
+	public:
+		// We perform these safety checks at the C# layer.
+		// The most important check is ensuring that the compressed tracks object is aligned to a 16 byte boundary.
+		static constexpr bool skip_initialize_safety_checks() { return true; }
+
+		static constexpr bool is_track_type_supported(acl::track_type8 type) { return type == acl::track_type8::float1f; }
+
+		// Force the version to the tagged 2.1 to decrease code size.
+		static constexpr acl::compressed_tracks_version16 version_supported() { return acl::compressed_tracks_version16::v02_01_00; }
+
+		// Todo: Make a separate variant for this when a user requests this feature.
+		static constexpr bool is_per_track_rounding_supported() { return false; }
+	};
+
+	using FloatDecompressionContext = acl::decompression_context<FloatDecompressionSettings>;
+}
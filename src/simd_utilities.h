@@ -0,0 +1,27 @@
+#pragma once
+
+#include "rtm/vector4f.h"
+
+namespace AclUnity
+{
+	// Transposes four rows of four floats into four columns. Each step maps to a single shuffle or unpack on SSE and NEON.
+	RTM_FORCE_INLINE void RTM_SIMD_CALL transpose4x4(rtm::vector4f_arg0 row0,
+													 rtm::vector4f_arg1 row1,
+													 rtm::vector4f_arg2 row2,
+													 rtm::vector4f_arg3 row3,
+													 rtm::vector4f&     outColumn0,
+													 rtm::vector4f&     outColumn1,
+													 rtm::vector4f&     outColumn2,
+													 rtm::vector4f&     outColumn3)
+	{
+		using rtm::mix4;
+		const rtm::vector4f x0x1y0y1 = rtm::vector_mix<mix4::x, mix4::a, mix4::y, mix4::b>(row0, row1);
+		const rtm::vector4f z0z1w0w1 = rtm::vector_mix<mix4::z, mix4::c, mix4::w, mix4::d>(row0, row1);
+		const rtm::vector4f x2x3y2y3 = rtm::vector_mix<mix4::x, mix4::a, mix4::y, mix4::b>(row2, row3);
+		const rtm::vector4f z2z3w2w3 = rtm::vector_mix<mix4::z, mix4::c, mix4::w, mix4::d>(row2, row3);
+		outColumn0 = rtm::vector_mix<mix4::x, mix4::y, mix4::a, mix4::b>(x0x1y0y1, x2x3y2y3);
+		outColumn1 = rtm::vector_mix<mix4::z, mix4::w, mix4::c, mix4::d>(x0x1y0y1, x2x3y2y3);
+		outColumn2 = rtm::vector_mix<mix4::x, mix4::y, mix4::a, mix4::b>(z0z1w0w1, z2z3w2w3);
+		outColumn3 = rtm::vector_mix<mix4::z, mix4::w, mix4::c, mix4::d>(z0z1w0w1, z2z3w2w3);
+	}
+}
@@ -0,0 +1,107 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+namespace AclUnity
+{
+	namespace
+	{
+		struct ParallelForState
+		{
+			std::atomic<uint32_t>          nextIndex;
+			std::atomic<uint32_t>          completedCount;
+			uint32_t                       count;
+			std::function<void(uint32_t)>  job;
+			std::mutex                     mutex;
+			std::condition_variable        finished;
+
+			ParallelForState(uint32_t count_, const std::function<void(uint32_t)>& job_) : nextIndex(0), completedCount(0), count(count_), job(job_) {}
+
+			void run()
+			{
+				for (;;)
+				{
+					const uint32_t index = nextIndex.fetch_add(1);
+					if (index >= count)
+						return;
+
+					job(index);
+
+					if (completedCount.fetch_add(1) + 1 == count)
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						finished.notify_all();
+					}
+				}
+			}
+		};
+	}
+
+	ThreadPool& ThreadPool::instance()
+	{
+		// The pool is intentionally leaked. Joining threads while the library is being unloaded can deadlock on some platforms,
+		// and the workers are idle on a condition variable whenever no compression is in flight.
+		static ThreadPool* pool = new ThreadPool();
+		return *pool;
+	}
+
+	ThreadPool::ThreadPool()
+	{
+		const uint32_t hardwareThreads = std::thread::hardware_concurrency();
+		const uint32_t numWorkers = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		m_workers.reserve(numWorkers);
+		for (uint32_t i = 0; i < numWorkers; i++)
+			m_workers.emplace_back(&ThreadPool::workerLoop, this);
+	}
+
+	void ThreadPool::enqueue(std::function<void()> task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_tasks.push_back(std::move(task));
+		}
+		m_condition.notify_one();
+	}
+
+	void ThreadPool::parallelFor(uint32_t count, uint32_t maxThreads, const std::function<void(uint32_t)>& job)
+	{
+		if (count == 0)
+			return;
+
+		uint32_t numHelpers = maxThreads == 0 ? getNumWorkers() : std::min(maxThreads - 1, getNumWorkers());
+		numHelpers = std::min(numHelpers, count - 1);
+		if (numHelpers == 0)
+		{
+			for (uint32_t i = 0; i < count; i++)
+				job(i);
+			return;
+		}
+
+		// Helpers which start after all indices have been claimed exit immediately, so the state must outlive this call.
+		std::shared_ptr<ParallelForState> state = std::make_shared<ParallelForState>(count, job);
+		for (uint32_t i = 0; i < numHelpers; i++)
+			enqueue([state]() { state->run(); });
+
+		state->run();
+
+		std::unique_lock<std::mutex> lock(state->mutex);
+		state->finished.wait(lock, [&state]() { return state->completedCount.load() == state->count; });
+	}
+
+	void ThreadPool::workerLoop()
+	{
+		for (;;)
+		{
+			std::function<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.wait(lock, [this]() { return !m_tasks.empty(); });
+				task = std::move(m_tasks.front());
+				m_tasks.pop_front();
+			}
+			task();
+		}
+	}
+}
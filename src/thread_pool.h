@@ -0,0 +1,42 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace AclUnity
+{
+	class ThreadPool
+	{
+	public:
+		/// Returns the process-wide pool, creating its workers on first use.
+		static ThreadPool& instance();
+
+		/// The number of worker threads owned by the pool, which does not include any calling thread.
+		uint32_t getNumWorkers() const { return static_cast<uint32_t>(m_workers.size()); }
+
+		/// Queues a task to run on a worker thread.
+		void enqueue(std::function<void()> task);
+
+		/// Invokes job for every index in [0, count) using up to maxThreads threads, including the calling thread.
+		/// A maxThreads of 0 uses every worker. The calling thread participates and only waits on indices already
+		/// claimed by other threads, so this may safely be nested inside tasks running on the pool.
+		void parallelFor(uint32_t count, uint32_t maxThreads, const std::function<void(uint32_t)>& job);
+
+	private:
+		ThreadPool();
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		void workerLoop();
+
+		std::vector<std::thread>          m_workers;
+		std::mutex                        m_mutex;
+		std::condition_variable           m_condition;
+		std::deque<std::function<void()>> m_tasks;
+	};
+}
@@ -0,0 +1,150 @@
+#include "archive.h"
+#include "test_utilities.h"
+
+using namespace AclUnityTests;
+
+namespace
+{
+	std::vector<unsigned char> readFile(const char* path)
+	{
+		std::vector<unsigned char> contents;
+		std::FILE* file = std::fopen(path, "rb");
+		if (file == nullptr)
+			return contents;
+		unsigned char buffer[4096];
+		size_t numRead;
+		while ((numRead = std::fread(buffer, 1, sizeof(buffer), file)) > 0)
+			contents.insert(contents.end(), buffer, buffer + numRead);
+		std::fclose(file);
+		return contents;
+	}
+
+	void writeFile(const char* path, const std::vector<unsigned char>& contents)
+	{
+		std::FILE* file = std::fopen(path, "wb");
+		TEST_CHECK(file != nullptr);
+		if (file == nullptr)
+			return;
+		TEST_CHECK(std::fwrite(contents.data(), 1, contents.size(), file) == contents.size());
+		std::fclose(file);
+	}
+
+	// Writes a copy of the archive with one patched 64-bit value and checks that openClipArchive rejects it
+	void checkRejectsPatchedArchive(const std::vector<unsigned char>& contents, size_t position, unsigned long long value)
+	{
+		const char* path = "aclunity_archive_patched.archive";
+		std::vector<unsigned char> patched = contents;
+		std::memcpy(patched.data() + position, &value, sizeof(value));
+		writeFile(path, patched);
+
+		void* archive = openClipArchive(path);
+		TEST_CHECK(archive == nullptr);
+		if (archive != nullptr)
+			closeClipArchive(archive);
+		std::remove(path);
+	}
+
+	void testEmptyArchive()
+	{
+		const char* path = "aclunity_archive_empty.archive";
+		TEST_CHECK(buildClipArchive(path, nullptr, nullptr, 0) == 1);
+		void* empty = openClipArchive(path);
+		TEST_CHECK(empty != nullptr);
+		if (empty != nullptr)
+		{
+			TEST_CHECK(getClipArchiveCount(empty) == 0);
+			TEST_CHECK(findClipInArchive(empty, 42) == -1);
+			TEST_CHECK(getClipFromArchive(empty, 0, nullptr, nullptr, nullptr, nullptr, nullptr) == nullptr);
+			closeClipArchive(empty);
+		}
+		std::remove(path);
+	}
+
+	void testArchiveRoundtrip()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+		int combinedSize = 0;
+		void* combined = compressCombined(clip, &combinedSize);
+
+		const char* path = "aclunity_archive.archive";
+		const unsigned long long nameHashes[] = { 0x9000, 0x10 };
+		const void* clips[] = { baseline, combined };
+		TEST_CHECK(buildClipArchive(path, nameHashes, clips, 2) == 1);
+		void* archive = openClipArchive(path);
+		TEST_CHECK(archive != nullptr);
+		if (archive != nullptr)
+		{
+			TEST_CHECK(getClipArchiveCount(archive) == 2);
+			const int tracksIndex = findClipInArchive(archive, 0x9000);
+			const int clipIndex = findClipInArchive(archive, 0x10);
+			TEST_CHECK(tracksIndex >= 0 && clipIndex >= 0);
+			TEST_CHECK(findClipInArchive(archive, 0x11) == -1);
+
+			int storedSize = 0;
+			int isCompressedClip = -1;
+			const void* storedTracks = getClipFromArchive(archive, tracksIndex, nullptr, nullptr, nullptr, &storedSize, &isCompressedClip);
+			TEST_CHECK(storedSize == size && isCompressedClip == 0);
+			checkMatchesBaseline(baseline, storedTracks, clip.numSamples);
+
+			int numTracks = 0;
+			const void* storedClip = getClipFromArchive(archive, clipIndex, nullptr, nullptr, &numTracks, &storedSize, &isCompressedClip);
+			TEST_CHECK(storedSize == combinedSize && isCompressedClip == 1 && numTracks == kNumBones);
+			std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+			samplePoseFromClip(storedClip, pose.data(), timeOf(9), 0);
+			TEST_CHECK(maxDifference(pose, samplePoseAt(baseline, nullptr, timeOf(9), 0)) == 0.f);
+			closeClipArchive(archive);
+		}
+
+		// Entries are sorted by hash, so the combined clip comes first. Each entry holds its hash followed by its offset.
+		const std::vector<unsigned char> contents = readFile(path);
+		TEST_CHECK(contents.size() > 16 + 2 * 32);
+		if (contents.size() > 16 + 2 * 32)
+		{
+			unsigned long long clipOffset = 0;
+			std::memcpy(&clipOffset, contents.data() + 16 + 8, sizeof(clipOffset));
+
+			// An offset pointing back into the entry table
+			checkRejectsPatchedArchive(contents, 16 + 8, 16);
+			// An offset past the end of the file
+			checkRejectsPatchedArchive(contents, 16 + 32 + 8, contents.size() + 16);
+			// A combined clip whose default pose offset and layout tag were overwritten
+			checkRejectsPatchedArchive(contents, static_cast<size_t>(clipOffset) + 24, 0);
+			// A combined clip whose transform tracks offset points past its end
+			checkRejectsPatchedArchive(contents, static_cast<size_t>(clipOffset), (static_cast<unsigned long long>(combinedSize) << 32) | static_cast<unsigned int>(combinedSize));
+		}
+		std::remove(path);
+
+		disposeCompressedClip(combined, nullptr);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	// Clips with an unknown layout tag are never written
+	void testUnknownClipRejected()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* combined = compressCombined(clip, &size);
+
+		std::vector<Float4> copy((static_cast<size_t>(size) + 15) / 16);
+		std::memcpy(copy[0].values, combined, static_cast<size_t>(size));
+		reinterpret_cast<CompressedClipHeader*>(copy[0].values)->layoutTag = 0;
+
+		const char* path = "aclunity_archive_rejected.archive";
+		const unsigned long long nameHash = 1;
+		const void* clips[] = { copy[0].values };
+		TEST_CHECK(buildClipArchive(path, &nameHash, clips, 1) == 0);
+		std::remove(path);
+
+		disposeCompressedClip(combined, nullptr);
+	}
+}
+
+int main()
+{
+	testEmptyArchive();
+	testArchiveRoundtrip();
+	testUnknownClipRejected();
+	return finishTests();
+}
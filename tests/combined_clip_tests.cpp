@@ -0,0 +1,151 @@
+#include "test_utilities.h"
+
+using namespace AclUnityTests;
+
+namespace
+{
+	void testClipWithoutScales()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+		void* combined = compressCombined(clip, &size);
+
+		const CompressedClipHeader* header = static_cast<const CompressedClipHeader*>(combined);
+		TEST_CHECK(header->layoutTag == ACL_UNITY_COMPRESSED_CLIP_LAYOUT_TAG);
+		TEST_CHECK(header->totalSizeInBytes == size);
+		TEST_CHECK(header->scaleTracksOffset == 0);
+		TEST_CHECK(header->staticPoseOffset == 0);
+
+		const void* transformTracks = static_cast<const unsigned char*>(combined) + header->transformTracksOffset;
+		checkMatchesBaseline(baseline, transformTracks, clip.numSamples);
+
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+		samplePoseFromClip(combined, pose.data(), timeOf(7), 0);
+		TEST_CHECK(maxDifference(pose, samplePoseAt(baseline, nullptr, timeOf(7), 0)) == 0.f);
+
+		disposeCompressedClip(combined, nullptr);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void testClipWithScales()
+	{
+		const TestClip clip = makeClip(40, true, 0.2f);
+		int size = 0;
+		void* combined = compressCombined(clip, &size);
+
+		const CompressedClipHeader* header = static_cast<const CompressedClipHeader*>(combined);
+		TEST_CHECK(header->scaleTracksOffset != 0);
+
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+		float scaleError = 0.f;
+		for (int s = 0; s < clip.numSamples; s++)
+		{
+			samplePoseFromClip(combined, pose.data(), timeOf(s), 3);
+			for (int b = 0; b < kNumBones; b++)
+				scaleError = std::max(scaleError, std::abs(pose[12 * b + 11] - clip.bone(b, s)[11]));
+		}
+		TEST_CHECK(scaleError < 0.001f);
+
+		disposeCompressedClip(combined, nullptr);
+	}
+
+	void testClipWithCurves()
+	{
+		const TestClip clip = makeClip(40, true, 0.2f);
+		const int numCurves = 2;
+		std::vector<float> curves(static_cast<size_t>(numCurves) * clip.numSamples);
+		for (int s = 0; s < clip.numSamples; s++)
+		{
+			curves[s]                   = std::sin(timeOf(s));
+			curves[clip.numSamples + s] = 0.5f;
+		}
+		float curveMaxErrors[numCurves] = { 0.0001f, 0.0001f };
+
+		int size = 0;
+		void* combined = compressSkeletonClipWithCurves(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance,
+														0.0001f, 0.00001f, numCurves, curves.data(), curveMaxErrors, &size, nullptr);
+		TEST_CHECK(combined != nullptr && size > 0);
+		TEST_CHECK(static_cast<const CompressedClipHeader*>(combined)->scalarTracksOffset != 0);
+
+		float curveError = 0.f;
+		std::vector<float> values(numCurves, 0.f);
+		for (int s = 0; s < clip.numSamples; s++)
+		{
+			sampleCurvesFromClip(combined, values.data(), timeOf(s), 3);
+			for (int c = 0; c < numCurves; c++)
+				curveError = std::max(curveError, std::abs(values[c] - curves[static_cast<size_t>(c) * clip.numSamples + s]));
+		}
+		TEST_CHECK(curveError < 0.001f);
+
+		// Sampling both parts together matches sampling each on its own
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+		std::vector<float> separatePose(pose.size(), 0.f);
+		std::vector<float> separateValues(numCurves, 0.f);
+		const float time = timeOf(13) + 0.4f / kSampleRate;
+		samplePoseAndCurvesFromClip(combined, pose.data(), values.data(), time, 0);
+		samplePoseFromClip(combined, separatePose.data(), time, 0);
+		sampleCurvesFromClip(combined, separateValues.data(), time, 0);
+		TEST_CHECK(maxDifference(pose, separatePose) == 0.f);
+		TEST_CHECK(values == separateValues);
+
+		// Clips without curves leave the curve output untouched
+		void* withoutCurves = compressCombined(clip, &size);
+		values.assign(numCurves, -7.f);
+		samplePoseAndCurvesFromClip(withoutCurves, pose.data(), values.data(), time, 0);
+		sampleCurvesFromClip(withoutCurves, values.data(), time, 0);
+		TEST_CHECK(values[0] == -7.f && values[1] == -7.f);
+
+		disposeCompressedClip(withoutCurves, nullptr);
+		disposeCompressedClip(combined, nullptr);
+	}
+
+	void testStaticClip()
+	{
+		const TestClip clip = makeClip(20, false, 0.f);
+		int size = 0;
+		void* combined = compressCombined(clip, &size);
+
+		const CompressedClipHeader* header = static_cast<const CompressedClipHeader*>(combined);
+		TEST_CHECK(header->staticPoseOffset != 0);
+
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+		samplePoseFromClip(combined, pose.data(), timeOf(3) + 0.4f / kSampleRate, 0);
+		TEST_CHECK(maxDifference(pose, rawPose(clip, 0)) < 0.001f);
+
+		const void* transformTracks = static_cast<const unsigned char*>(combined) + header->transformTracksOffset;
+		TEST_CHECK(maxDifference(pose, samplePoseAt(transformTracks, nullptr, timeOf(11), 0)) == 0.f);
+
+		disposeCompressedClip(combined, nullptr);
+	}
+
+	// Samplers leave the output untouched for blobs whose header has an unknown layout tag
+	void testUnknownClipLayout()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* combined = compressCombined(clip, &size);
+
+		std::vector<Float4> copy((static_cast<size_t>(size) + 15) / 16);
+		std::memcpy(copy[0].values, combined, static_cast<size_t>(size));
+		reinterpret_cast<CompressedClipHeader*>(copy[0].values)->layoutTag = 0;
+
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, -7.f);
+		samplePoseFromClip(copy[0].values, pose.data(), timeOf(5), 0);
+		TEST_CHECK(pose[0] == -7.f && pose[12 * kNumBones - 1] == -7.f);
+		samplePoseFromClipBlendedAdd(copy[0].values, pose.data(), 0.5f, timeOf(5), 0);
+		TEST_CHECK(pose[0] == -7.f && pose[12 * kNumBones - 1] == -7.f);
+
+		disposeCompressedClip(combined, nullptr);
+	}
+}
+
+int main()
+{
+	testClipWithoutScales();
+	testClipWithScales();
+	testClipWithCurves();
+	testStaticClip();
+	testUnknownClipLayout();
+	return finishTests();
+}
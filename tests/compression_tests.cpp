@@ -0,0 +1,624 @@
+#include "test_utilities.h"
+
+using namespace AclUnityTests;
+
+namespace
+{
+	void* compressWithOptions(const TestClip& clip, const CompressionOptions* options, int* outSizeInBytes)
+	{
+		return compressSkeletonClipWithOptions(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, outSizeInBytes, nullptr, options);
+	}
+
+	float measureError(const TestClip& clip, const void* compressedTransformTracks, const CompressionOptions* options)
+	{
+		return measureSkeletonClipError(kParentIndices, kNumBones, clip.get(), clip.numSamples, compressedTransformTracks, nullptr, kShellDistance, options, 0,
+										nullptr, nullptr, 0, 0.f, nullptr, nullptr, nullptr);
+	}
+
+	std::vector<Float4> toFrameMajor(const TestClip& clip)
+	{
+		std::vector<Float4> frameMajor(clip.data.size());
+		for (int b = 0; b < kNumBones; b++)
+		{
+			for (int s = 0; s < clip.numSamples; s++)
+				std::memcpy(frameMajor[3 * (static_cast<size_t>(s) * kNumBones + b)].values, clip.bone(b, s), 12 * sizeof(float));
+		}
+		return frameMajor;
+	}
+
+	std::vector<Float4> toSoa(const TestClip& clip)
+	{
+		static const int kStreamSources[11] = { 0, 1, 2, 3, 4, 5, 6, 8, 9, 10, 11 };
+		const size_t count = static_cast<size_t>(kNumBones) * clip.numSamples;
+		std::vector<Float4> soa((11 * count + 3) / 4);
+		float* streams = soa[0].values;
+		for (int b = 0; b < kNumBones; b++)
+		{
+			for (int s = 0; s < clip.numSamples; s++)
+			{
+				const size_t index = static_cast<size_t>(s) * kNumBones + b;
+				for (int stream = 0; stream < 11; stream++)
+					streams[stream * count + index] = clip.bone(b, s)[kStreamSources[stream]];
+			}
+		}
+		return soa;
+	}
+
+	void testOptionsMatchBaseline()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int baselineSize = 0;
+		void* baseline = compressBaseline(clip, &baselineSize);
+
+		int size = 0;
+		void* withoutOptions = compressWithOptions(clip, nullptr, &size);
+		TEST_CHECK(size == baselineSize);
+		checkMatchesBaseline(baseline, withoutOptions, clip.numSamples);
+
+		const CompressionOptions options = CompressionOptions();
+		void* zeroOptions = compressWithOptions(clip, &options, &size);
+		TEST_CHECK(size == baselineSize);
+		checkMatchesBaseline(baseline, zeroOptions, clip.numSamples);
+
+		disposeCompressedTracksBuffer(zeroOptions);
+		disposeCompressedTracksBuffer(withoutOptions);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void testBoneRadii()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int baselineSize = 0;
+		void* baseline = compressBaseline(clip, &baselineSize);
+
+		// Bones without skinned vertices anywhere in their subtree fall back to sampledErrorDistanceFromBone
+		const float noRadii[kNumBones] = {};
+		CompressionOptions options = CompressionOptions();
+		options.boneRadii = noRadii;
+		int size = 0;
+		void* fallback = compressWithOptions(clip, &options, &size);
+		TEST_CHECK(size == baselineSize);
+		checkMatchesBaseline(baseline, fallback, clip.numSamples);
+
+		// Only the leaf at the end of the 0-1-2-3 chain is skinned, so its ancestors inherit its radius plus the chain length
+		// while bone 4 keeps the fallback. The clip must stay within the error threshold measured with the same shells.
+		const float leafRadius[kNumBones] = { 0.f, 0.f, 0.f, 0.5f, 0.f };
+		options.boneRadii = leafRadius;
+		void* skinned = compressWithOptions(clip, &options, &size);
+		TEST_CHECK(skinned != nullptr && size > 0);
+		TEST_CHECK(measureError(clip, skinned, &options) < 10.f * kMaxDistanceError);
+
+		disposeCompressedTracksBuffer(skinned);
+		disposeCompressedTracksBuffer(fallback);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	// Every temporary is released through the callbacks, leaving only the returned buffers until they are disposed with them
+	void testAllocatorCallbacks()
+	{
+		const TestClip clip = makeClip(40, true, 0.2f);
+		int baselineSize = 0;
+		void* baseline = compressBaseline(clip, &baselineSize);
+
+		CountingAllocator allocator;
+		CompressionOptions options = CompressionOptions();
+		options.allocator = &allocator.callbacks;
+		int size = 0;
+		void* tracks = compressWithOptions(clip, &options, &size);
+		TEST_CHECK(size == baselineSize);
+		TEST_CHECK(allocator.numAllocations.load() > 1);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 1);
+		checkMatchesBaseline(baseline, tracks, clip.numSamples);
+		disposeCompressedTracksBufferWithAllocator(tracks, &allocator.callbacks);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+		TEST_CHECK(allocator.numLiveBytes.load() == 0);
+
+		void* combined = compressSkeletonClipWithScales(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance,
+														0.0001f, 0.00001f, &size, &options);
+		TEST_CHECK(combined != nullptr && allocator.numLiveAllocations.load() == 1);
+		disposeCompressedClip(combined, &allocator.callbacks);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+		TEST_CHECK(allocator.numLiveBytes.load() == 0);
+
+		// Batches share the callbacks across threads
+		const int numClips = 4;
+		SkeletonClipDescriptor descriptors[numClips];
+		for (int i = 0; i < numClips; i++)
+		{
+			descriptors[i].aosClipData                  = clip.get();
+			descriptors[i].sampledScales                = nullptr;
+			descriptors[i].numSamples                   = clip.numSamples;
+			descriptors[i].sampleRate                   = kSampleRate;
+			descriptors[i].maxDistanceError             = kMaxDistanceError;
+			descriptors[i].sampledErrorDistanceFromBone = kShellDistance;
+			descriptors[i].compressionLevel             = 2;
+			descriptors[i].outStatistics                = nullptr;
+		}
+		void* buffers[numClips] = {};
+		int   sizes[numClips]   = {};
+		compressSkeletonClipBatch(kParentIndices, kNumBones, descriptors, numClips, &options, 0, buffers, sizes);
+		TEST_CHECK(allocator.numLiveAllocations.load() == numClips);
+		for (int i = 0; i < numClips; i++)
+			disposeCompressedTracksBufferWithAllocator(buffers[i], &allocator.callbacks);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+		TEST_CHECK(allocator.numLiveBytes.load() == 0);
+
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void testInPlaceMatchesBaseline()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int baselineSize = 0;
+		void* baseline = compressBaseline(clip, &baselineSize);
+
+		CountingAllocator copyAllocator;
+		CompressionOptions options = CompressionOptions();
+		options.allocator = &copyAllocator.callbacks;
+		int size = 0;
+		void* copied = compressWithOptions(clip, &options, &size);
+
+		CountingAllocator inPlaceAllocator;
+		options.allocator = &inPlaceAllocator.callbacks;
+		TestClip consumed = clip;
+		void* inPlace = compressSkeletonClipInPlace(kParentIndices, kNumBones, 2, consumed.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr, &options);
+		TEST_CHECK(size == baselineSize);
+		checkMatchesBaseline(baseline, inPlace, clip.numSamples);
+
+		// Referencing the caller's samples keeps the raw clip copy out of peak memory
+		const long long rawSizeInBytes = static_cast<long long>(clip.data.size() * sizeof(Float4));
+		TEST_CHECK(inPlaceAllocator.numPeakBytes.load() + rawSizeInBytes <= copyAllocator.numPeakBytes.load());
+
+		disposeCompressedTracksBufferWithAllocator(inPlace, &inPlaceAllocator.callbacks);
+		disposeCompressedTracksBufferWithAllocator(copied, &copyAllocator.callbacks);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void testLayoutsMatchBaseline()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+
+		const std::vector<Float4> frameMajor = toFrameMajor(clip);
+		CompressionOptions options = CompressionOptions();
+		options.clipDataLayout = 1;
+		void* fromFrameMajor = compressSkeletonClipWithOptions(kParentIndices, kNumBones, 2, frameMajor[0].values, clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr, &options);
+		checkMatchesBaseline(baseline, fromFrameMajor, clip.numSamples);
+		TEST_CHECK(measureError(clip, fromFrameMajor, nullptr) == measureError(clip, baseline, nullptr));
+
+		std::vector<Float4> consumedFrameMajor = frameMajor;
+		void* fromFrameMajorInPlace = compressSkeletonClipInPlace(kParentIndices, kNumBones, 2, consumedFrameMajor[0].values, clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr, &options);
+		checkMatchesBaseline(baseline, fromFrameMajorInPlace, clip.numSamples);
+
+		// SOA data is transposed into a temporary copy, so even in-place compression leaves it unchanged
+		const std::vector<Float4> soa = toSoa(clip);
+		std::vector<Float4> consumedSoa = soa;
+		options.clipDataLayout = 2;
+		void* fromSoa = compressSkeletonClipInPlace(kParentIndices, kNumBones, 2, consumedSoa[0].values, clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr, &options);
+		checkMatchesBaseline(baseline, fromSoa, clip.numSamples);
+		TEST_CHECK(std::memcmp(consumedSoa[0].values, soa[0].values, soa.size() * sizeof(Float4)) == 0);
+
+		disposeCompressedTracksBuffer(fromSoa);
+		disposeCompressedTracksBuffer(fromFrameMajorInPlace);
+		disposeCompressedTracksBuffer(fromFrameMajor);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void testStatistics()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int baselineSize = 0;
+		void* baseline = compressBaseline(clip, &baselineSize);
+
+		// Statistics are measured after compressing, so requesting them never changes the result
+		CompressionStatistics statistics;
+		std::memset(&statistics, 0xff, sizeof(statistics));
+		CompressionOptions options = CompressionOptions();
+		options.outStatistics = &statistics;
+		int size = 0;
+		void* tracks = compressWithOptions(clip, &options, &size);
+		checkMatchesBaseline(baseline, tracks, clip.numSamples);
+
+		TEST_CHECK(statistics.compressedSizeInBytes == size);
+		TEST_CHECK(statistics.rawSizeInBytes == kNumBones * clip.numSamples * 12 * static_cast<int>(sizeof(float)));
+		TEST_CHECK(statistics.compressionTimeInSeconds > 0.f);
+		TEST_CHECK(statistics.maxError >= 0.f && statistics.maxError < 10.f * kMaxDistanceError);
+		TEST_CHECK(statistics.maxErrorBone >= 0 && statistics.maxErrorBone < kNumBones);
+		TEST_CHECK(statistics.maxErrorTime >= 0.f && statistics.maxErrorTime <= timeOf(clip.numSamples - 1));
+		// 40 samples never fit in a single segment of the default ideal size of 16
+		TEST_CHECK(statistics.numSegments >= 2);
+
+		// Every bone rotates, only the root translates, and nothing stretches
+		TEST_CHECK(statistics.numAnimatedRotationSubTracks == kNumBones);
+		TEST_CHECK(statistics.numConstantRotationSubTracks == 0);
+		TEST_CHECK(statistics.numAnimatedTranslationSubTracks == 1);
+		TEST_CHECK(statistics.numConstantTranslationSubTracks == kNumBones - 1);
+		TEST_CHECK(statistics.numDefaultTranslationSubTracks == 0);
+		TEST_CHECK(statistics.numAnimatedScaleSubTracks == 0);
+		TEST_CHECK(statistics.numConstantScaleSubTracks == 0);
+		TEST_CHECK(statistics.numDefaultScaleSubTracks == kNumBones);
+
+		const TestClip staticClip = makeClip(40, false, 0.f);
+		void* staticTracks = compressWithOptions(staticClip, &options, &size);
+		TEST_CHECK(statistics.compressedSizeInBytes == size);
+		TEST_CHECK(statistics.numAnimatedRotationSubTracks == 0);
+		TEST_CHECK(statistics.numConstantRotationSubTracks == kNumBones);
+		TEST_CHECK(statistics.numAnimatedTranslationSubTracks == 0);
+		TEST_CHECK(statistics.maxError < 10.f * kMaxDistanceError);
+
+		// Scalar clips leave the sub-track counts at zero
+		const int numCurveSamples = 20;
+		std::vector<float> curves(2 * numCurveSamples);
+		for (int s = 0; s < numCurveSamples; s++)
+		{
+			curves[s]                   = std::sin(timeOf(s));
+			curves[numCurveSamples + s] = 2.f;
+		}
+		float curveMaxErrors[2] = { 0.001f, 0.001f };
+		void* scalars = compressScalarsClipWithOptions(2, 2, curves.data(), numCurveSamples, kSampleRate, curveMaxErrors, &size, &options);
+		TEST_CHECK(statistics.compressedSizeInBytes == size);
+		TEST_CHECK(statistics.rawSizeInBytes == 2 * numCurveSamples * static_cast<int>(sizeof(float)));
+		TEST_CHECK(statistics.maxError >= 0.f && statistics.maxError < 0.002f);
+		TEST_CHECK(statistics.maxErrorBone >= 0 && statistics.maxErrorBone < 2);
+		TEST_CHECK(statistics.numAnimatedRotationSubTracks == 0 && statistics.numDefaultScaleSubTracks == 0);
+
+		disposeCompressedTracksBuffer(scalars);
+		disposeCompressedTracksBuffer(staticTracks);
+		disposeCompressedTracksBuffer(tracks);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void testMeasureError()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+
+		const int numBuckets = 8;
+		std::vector<int>   histograms(static_cast<size_t>(kNumBones) * numBuckets, -1);
+		std::vector<float> boneErrors(static_cast<size_t>(kNumBones), -1.f);
+		std::vector<float> sampleErrors(static_cast<size_t>(clip.numSamples), -1.f);
+		int worstBone = -1;
+		int worstSample = -1;
+		const float maxError = measureSkeletonClipError(kParentIndices, kNumBones, clip.get(), clip.numSamples, baseline, nullptr, kShellDistance, nullptr, 0,
+														boneErrors.data(), sampleErrors.data(), numBuckets, 10.f * kMaxDistanceError, histograms.data(), &worstBone, &worstSample);
+
+		TEST_CHECK(maxError >= 0.f && maxError < 10.f * kMaxDistanceError);
+		TEST_CHECK(worstBone >= 0 && worstBone < kNumBones);
+		TEST_CHECK(worstSample >= 0 && worstSample < clip.numSamples);
+		TEST_CHECK(boneErrors[worstBone] == maxError);
+		TEST_CHECK(sampleErrors[worstSample] == maxError);
+		TEST_CHECK(*std::max_element(boneErrors.begin(), boneErrors.end()) == maxError);
+		TEST_CHECK(*std::max_element(sampleErrors.begin(), sampleErrors.end()) == maxError);
+		TEST_CHECK(*std::min_element(sampleErrors.begin(), sampleErrors.end()) >= 0.f);
+		for (int b = 0; b < kNumBones; b++)
+		{
+			int count = 0;
+			for (int bucket = 0; bucket < numBuckets; bucket++)
+				count += histograms[static_cast<size_t>(b) * numBuckets + bucket];
+			TEST_CHECK(count == clip.numSamples);
+		}
+
+		// Samples are split across threads, which must not change any result
+		std::vector<float> serialBoneErrors(static_cast<size_t>(kNumBones), -1.f);
+		const float serialMaxError = measureSkeletonClipError(kParentIndices, kNumBones, clip.get(), clip.numSamples, baseline, nullptr, kShellDistance, nullptr, 1,
+															  serialBoneErrors.data(), nullptr, 0, 0.f, nullptr, nullptr, nullptr);
+		TEST_CHECK(serialMaxError == maxError);
+		TEST_CHECK(serialBoneErrors == boneErrors);
+
+		// Static clips only store constant samples, which must stay within the threshold as well
+		const TestClip staticClip = makeClip(40, false, 0.f);
+		void* staticTracks = compressBaseline(staticClip, &size);
+		TEST_CHECK(measureError(staticClip, staticTracks, nullptr) < 10.f * kMaxDistanceError);
+
+		disposeCompressedTracksBuffer(staticTracks);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void* compressToBudget(const TestClip& clip, int targetSizeInBytes, float targetBytesPerSecond, float minDistanceError, float maxDistanceError, int* outSizeInBytes, float* outAchievedDistanceError)
+	{
+		return compressSkeletonClipToBudget(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, targetSizeInBytes, targetBytesPerSecond,
+											minDistanceError, maxDistanceError, 8, kShellDistance, outSizeInBytes, outAchievedDistanceError, nullptr, nullptr);
+	}
+
+	void testBudgetSearch()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		const float minError = 0.00001f;
+		const float maxError = 0.01f;
+
+		// Without a budget the clip compresses once at the largest error
+		int looseSize = 0;
+		float achievedError = 0.f;
+		void* loose = compressToBudget(clip, 0, 0.f, minError, maxError, &looseSize, &achievedError);
+		TEST_CHECK(achievedError == maxError);
+		int tightSize = 0;
+		void* tight = compressToBudget(clip, 0, 0.f, minError, minError, &tightSize, &achievedError);
+		TEST_CHECK(achievedError == minError);
+		TEST_CHECK(tightSize > looseSize);
+
+		// A budget everything fits stops at the smallest error
+		int size = 0;
+		void* roomy = compressToBudget(clip, tightSize, 0.f, minError, maxError, &size, &achievedError);
+		TEST_CHECK(achievedError == minError && size == tightSize);
+
+		// A budget in between bisects to an error inside the range whose result fits
+		const int budget = (tightSize + looseSize) / 2;
+		void* between = compressToBudget(clip, budget, 0.f, minError, maxError, &size, &achievedError);
+		TEST_CHECK(size <= budget);
+		TEST_CHECK(achievedError > minError && achievedError <= maxError);
+		TEST_CHECK(measureError(clip, between, nullptr) < 10.f * achievedError);
+
+		// The per second budget scales with the clip duration
+		const float duration = timeOf(clip.numSamples - 1);
+		void* perSecond = compressToBudget(clip, 0, static_cast<float>(budget) / duration, minError, maxError, &size, &achievedError);
+		TEST_CHECK(size <= budget);
+
+		// A budget nothing fits returns the clip compressed at the largest error at the highest level
+		void* impossible = compressToBudget(clip, 1, 0.f, minError, maxError, &size, &achievedError);
+		TEST_CHECK(impossible != nullptr && size > 1);
+		TEST_CHECK(achievedError == maxError);
+
+		disposeCompressedTracksBuffer(impossible);
+		disposeCompressedTracksBuffer(perSecond);
+		disposeCompressedTracksBuffer(between);
+		disposeCompressedTracksBuffer(roomy);
+		disposeCompressedTracksBuffer(tight);
+		disposeCompressedTracksBuffer(loose);
+	}
+
+	void testTunedCompression()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		const int numCandidates = 3;
+		CompressionCandidate candidates[numCandidates];
+		for (int i = 0; i < numCandidates; i++)
+		{
+			candidates[i].compressionLevel       = 2;
+			candidates[i].idealSamplesPerSegment = 8 << i;
+			candidates[i].maxSamplesPerSegment   = 0;
+		}
+
+		CompressionStatistics statistics;
+		CompressionOptions options = CompressionOptions();
+		options.outStatistics = &statistics;
+		CompressionCandidateResult results[numCandidates];
+		int chosen = -1;
+		int size = 0;
+		void* smallest = compressSkeletonClipTuned(kParentIndices, kNumBones, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr, &options,
+												   candidates, numCandidates, 0.f, 16, 0, 0, results, &chosen);
+		TEST_CHECK(chosen >= 0 && chosen < numCandidates);
+		for (int i = 0; i < numCandidates; i++)
+		{
+			TEST_CHECK(results[i].compressedSizeInBytes > 0 && results[i].compressedSizeInBytes >= results[chosen].compressedSizeInBytes);
+			TEST_CHECK(results[i].decodeTimeInNanoseconds > 0.f);
+			TEST_CHECK(results[i].maxError >= 0.f && results[i].maxError < 10.f * kMaxDistanceError);
+		}
+		// Larger segments never need more of them
+		TEST_CHECK(results[0].numSegments >= results[1].numSegments && results[1].numSegments >= results[2].numSegments);
+		TEST_CHECK(size == results[chosen].compressedSizeInBytes);
+		TEST_CHECK(statistics.compressedSizeInBytes == size && statistics.numSegments == results[chosen].numSegments);
+
+		// The chosen candidate is exactly what compressing with its settings produces
+		CompressionOptions chosenOptions = CompressionOptions();
+		chosenOptions.idealSamplesPerSegment = candidates[chosen].idealSamplesPerSegment;
+		int chosenSize = 0;
+		void* expected = compressWithOptions(clip, &chosenOptions, &chosenSize);
+		TEST_CHECK(chosenSize == size);
+		checkMatchesBaseline(expected, smallest, clip.numSamples);
+
+		// Weighting decode time picks the candidate with the best combined score
+		const float bytesPerDecodeNanosecond = 1000.f;
+		void* weighted = compressSkeletonClipTuned(kParentIndices, kNumBones, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr, nullptr,
+												   candidates, numCandidates, bytesPerDecodeNanosecond, 16, 0, 0, results, &chosen);
+		const float chosenScore = static_cast<float>(results[chosen].compressedSizeInBytes) + bytesPerDecodeNanosecond * results[chosen].decodeTimeInNanoseconds;
+		for (int i = 0; i < numCandidates; i++)
+			TEST_CHECK(chosenScore <= static_cast<float>(results[i].compressedSizeInBytes) + bytesPerDecodeNanosecond * results[i].decodeTimeInNanoseconds);
+		TEST_CHECK(size == results[chosen].compressedSizeInBytes);
+
+		disposeCompressedTracksBuffer(weighted);
+		disposeCompressedTracksBuffer(expected);
+		disposeCompressedTracksBuffer(smallest);
+	}
+
+	// Clips with a default pose and scales are timed with the sampler they need, which must also accept the chosen clip
+	void testTunedCompressionWithDefaultsAndScales()
+	{
+		const TestClip clip = makeClip(40, true, 0.2f);
+		std::vector<float> sampledScales(static_cast<size_t>(kNumBones) * clip.numSamples);
+		for (int s = 0; s < clip.numSamples; s++)
+		{
+			for (int b = 0; b < kNumBones; b++)
+				sampledScales[static_cast<size_t>(s) * kNumBones + b] = clip.bone(b, s)[11];
+		}
+		const std::vector<float> defaultPose = rawPose(clip, 0);
+
+		CountingAllocator allocator;
+		CompressionOptions options = CompressionOptions();
+		options.defaultPose = defaultPose.data();
+		options.allocator   = &allocator.callbacks;
+		CompressionCandidate candidates[2] = { { 2, 8, 0 }, { 2, 16, 0 } };
+		CompressionCandidateResult results[2];
+		int size = 0;
+		void* tuned = compressSkeletonClipTuned(kParentIndices, kNumBones, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, sampledScales.data(), &options,
+												candidates, 2, 0.f, 16, 1, 0, results, nullptr);
+		TEST_CHECK(results[0].decodeTimeInNanoseconds > 0.f && results[1].decodeTimeInNanoseconds > 0.f);
+		// The timed scale tracks are released along with the rejected candidate
+		TEST_CHECK(allocator.numLiveAllocations.load() == 1);
+
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+		samplePoseWithDefaults(tuned, nullptr, defaultPose.data(), pose.data(), timeOf(0), 3);
+		TEST_CHECK(maxDifference(pose, defaultPose) < 0.01f);
+
+		disposeCompressedTracksBufferWithAllocator(tuned, &allocator.callbacks);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+	}
+
+	void testSegmentSizes()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		CompressionStatistics statistics;
+		CompressionOptions options = CompressionOptions();
+		options.outStatistics = &statistics;
+
+		// A large ideal segment size with the default maximum raises the maximum to match
+		options.idealSamplesPerSegment = 48;
+		int size = 0;
+		void* singleSegment = compressWithOptions(clip, &options, &size);
+		TEST_CHECK(singleSegment != nullptr && size > 0);
+		TEST_CHECK(statistics.numSegments == 1);
+
+		options.idealSamplesPerSegment = 8;
+		options.maxSamplesPerSegment   = 8;
+		void* smallSegments = compressWithOptions(clip, &options, &size);
+		TEST_CHECK(statistics.numSegments >= 5);
+		TEST_CHECK(measureError(clip, smallSegments, nullptr) < 10.f * kMaxDistanceError);
+
+		// The benchmark pairs each ideal size with ACL's maximum ratio, returns nothing, and leaks nothing
+		CountingAllocator allocator;
+		CompressionOptions benchmarkOptions = CompressionOptions();
+		benchmarkOptions.allocator     = &allocator.callbacks;
+		benchmarkOptions.outStatistics = &statistics;
+		statistics.numSegments = -1;
+		const int idealSizes[] = { 8, 16, 48 };
+		CompressionCandidateResult results[3];
+		benchmarkSkeletonClipSegmentSizes(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, nullptr, &benchmarkOptions,
+										  idealSizes, 3, 16, 0, 0, results);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+		TEST_CHECK(statistics.numSegments == -1);
+		TEST_CHECK(results[0].numSegments >= results[1].numSegments && results[1].numSegments >= results[2].numSegments);
+		TEST_CHECK(results[2].numSegments == 1);
+		for (int i = 0; i < 3; i++)
+			TEST_CHECK(results[i].compressedSizeInBytes > 0 && results[i].decodeTimeInNanoseconds > 0.f);
+
+		disposeCompressedTracksBuffer(smallSegments);
+		disposeCompressedTracksBuffer(singleSegment);
+	}
+
+	// Uniform scales take part in the shell error through the scale metric, so a scaled clip must measure within the threshold
+	// when its error is measured with the same scales
+	void testScaleErrorMetric()
+	{
+		const TestClip clip = makeClip(40, true, 0.2f);
+		std::vector<float> sampledScales(static_cast<size_t>(kNumBones) * clip.numSamples);
+		std::vector<float> scaleTracks(sampledScales.size());
+		for (int b = 0; b < kNumBones; b++)
+		{
+			for (int s = 0; s < clip.numSamples; s++)
+			{
+				sampledScales[static_cast<size_t>(s) * kNumBones + b] = clip.bone(b, s)[11];
+				scaleTracks[static_cast<size_t>(b) * clip.numSamples + s] = clip.bone(b, s)[11];
+			}
+		}
+
+		std::vector<float> scaleErrors(static_cast<size_t>(kNumBones), 0.00001f);
+		int size = 0;
+		void* scales = compressScalarsClip(kNumBones, 2, scaleTracks.data(), clip.numSamples, kSampleRate, scaleErrors.data(), &size);
+		void* tracks = compressSkeletonClip(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, sampledScales.data());
+		TEST_CHECK(scales != nullptr && tracks != nullptr);
+
+		const float maxError = measureSkeletonClipError(kParentIndices, kNumBones, clip.get(), clip.numSamples, tracks, scales, kShellDistance, nullptr, 0,
+														nullptr, nullptr, 0, 0.f, nullptr, nullptr, nullptr);
+		TEST_CHECK(maxError >= 0.f && maxError < 10.f * kMaxDistanceError);
+
+		disposeCompressedTracksBuffer(tracks);
+		disposeCompressedTracksBuffer(scales);
+	}
+
+	// Every child of the root shares one depth level, so the error metric composes them four at a time. The measurement
+	// composes bones one at a time, and both must agree that the clip stays within the threshold.
+	void testWideSkeleton()
+	{
+		const signed short parentIndices[] = { 0, 0, 0, 0, 0, 0, 1 };
+		const signed short numBones = 7;
+		const int numSamples = 40;
+		std::vector<Float4> data(static_cast<size_t>(numBones) * numSamples * 3);
+		for (int b = 0; b < numBones; b++)
+		{
+			for (int s = 0; s < numSamples; s++)
+			{
+				const float angle = 0.3f * static_cast<float>(b + 1) * (1.f + timeOf(s));
+				float* bone = data[3 * (static_cast<size_t>(b) * numSamples + s)].values;
+				bone[0]  = 0.f;
+				bone[1]  = 0.f;
+				bone[2]  = std::sin(0.5f * angle);
+				bone[3]  = std::cos(0.5f * angle);
+				bone[4]  = b == 0 ? timeOf(s) : 0.1f;
+				bone[5]  = 0.02f * static_cast<float>(b);
+				bone[6]  = 0.f;
+				bone[7]  = 0.f;
+				bone[8]  = 1.f;
+				bone[9]  = 1.f;
+				bone[10] = 1.f;
+				bone[11] = 1.f;
+			}
+		}
+
+		int size = 0;
+		void* tracks = compressSkeletonClip(parentIndices, numBones, 2, data[0].values, numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr);
+		TEST_CHECK(tracks != nullptr && size > 0);
+		const float maxError = measureSkeletonClipError(parentIndices, numBones, data[0].values, numSamples, tracks, nullptr, kShellDistance, nullptr, 0,
+														nullptr, nullptr, 0, 0.f, nullptr, nullptr, nullptr);
+		TEST_CHECK(maxError >= 0.f && maxError < 10.f * kMaxDistanceError);
+
+		disposeCompressedTracksBuffer(tracks);
+	}
+
+	void testKeyframeStripping()
+	{
+		const TestClip clip = makeClip(60, true, 0.f);
+		int baselineSize = 0;
+		void* baseline = compressBaseline(clip, &baselineSize);
+
+		CompressionStatistics statistics;
+		CompressionOptions options = CompressionOptions();
+		options.outStatistics = &statistics;
+		options.keyframeStrippingProportion = 0.5f;
+		int proportionSize = 0;
+		void* byProportion = compressWithOptions(clip, &options, &proportionSize);
+		TEST_CHECK(byProportion != nullptr && proportionSize < baselineSize);
+		TEST_CHECK(statistics.compressedSizeInBytes == proportionSize);
+		// Stripped keyframes are interpolated, so the reported error may exceed the threshold but must agree with a separate measurement
+		const float measuredError = measureError(clip, byProportion, nullptr);
+		TEST_CHECK(statistics.maxError >= 0.f && std::abs(statistics.maxError - measuredError) <= 0.01f * measuredError + 0.000001f);
+
+		// A threshold larger than any keyframe's contribution strips at least as much as half of them
+		options.keyframeStrippingProportion = 0.f;
+		options.keyframeStrippingThreshold  = 1.f;
+		int thresholdSize = 0;
+		void* byThreshold = compressWithOptions(clip, &options, &thresholdSize);
+		TEST_CHECK(byThreshold != nullptr && thresholdSize <= proportionSize);
+		TEST_CHECK(statistics.maxError < 1.f + kMaxDistanceError);
+
+		// Both options strip the keyframes matching either
+		options.keyframeStrippingProportion = 0.5f;
+		int combinedSize = 0;
+		void* combined = compressWithOptions(clip, &options, &combinedSize);
+		TEST_CHECK(combinedSize <= thresholdSize && combinedSize <= proportionSize);
+
+		disposeCompressedTracksBuffer(combined);
+		disposeCompressedTracksBuffer(byThreshold);
+		disposeCompressedTracksBuffer(byProportion);
+		disposeCompressedTracksBuffer(baseline);
+	}
+}
+
+int main()
+{
+	testOptionsMatchBaseline();
+	testBoneRadii();
+	testAllocatorCallbacks();
+	testInPlaceMatchesBaseline();
+	testLayoutsMatchBaseline();
+	testStatistics();
+	testMeasureError();
+	testBudgetSearch();
+	testTunedCompression();
+	testTunedCompressionWithDefaultsAndScales();
+	testSegmentSizes();
+	testScaleErrorMetric();
+	testWideSkeleton();
+	testKeyframeStripping();
+	return finishTests();
+}
@@ -0,0 +1,121 @@
+#include "test_utilities.h"
+
+using namespace AclUnityTests;
+
+namespace
+{
+	void testBatchMatchesBaseline()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		const TestClip staticClip = makeClip(40, false, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+		int staticSize = 0;
+		void* staticBaseline = compressBaseline(staticClip, &staticSize);
+
+		// Alternating clips make sure each output lands in the slot of its own descriptor
+		const int numClips = 5;
+		SkeletonClipDescriptor descriptors[numClips];
+		for (int i = 0; i < numClips; i++)
+		{
+			descriptors[i].aosClipData                  = i % 2 == 0 ? clip.get() : staticClip.get();
+			descriptors[i].sampledScales                = nullptr;
+			descriptors[i].numSamples                   = clip.numSamples;
+			descriptors[i].sampleRate                   = kSampleRate;
+			descriptors[i].maxDistanceError             = kMaxDistanceError;
+			descriptors[i].sampledErrorDistanceFromBone = kShellDistance;
+			descriptors[i].compressionLevel             = 2;
+			descriptors[i].outStatistics                = nullptr;
+		}
+
+		// A single thread runs everything on the calling thread, which must produce the same buffers as the pool
+		const int maxThreads[] = { 0, 1, 3 };
+		for (int threads : maxThreads)
+		{
+			void* buffers[numClips] = {};
+			int   sizes[numClips]   = {};
+			compressSkeletonClipBatch(kParentIndices, kNumBones, descriptors, numClips, nullptr, threads, buffers, sizes);
+			for (int i = 0; i < numClips; i++)
+			{
+				TEST_CHECK(sizes[i] == (i % 2 == 0 ? size : staticSize));
+				checkMatchesBaseline(i % 2 == 0 ? baseline : staticBaseline, buffers[i], clip.numSamples);
+				disposeCompressedTracksBuffer(buffers[i]);
+			}
+		}
+
+		compressSkeletonClipBatch(kParentIndices, kNumBones, descriptors, 0, nullptr, 0, nullptr, nullptr);
+
+		disposeCompressedTracksBuffer(staticBaseline);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void* beginCompression(const TestClip& clip, const CompressionOptions* options)
+	{
+		return beginCompressSkeletonClip(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, nullptr, options);
+	}
+
+	void testAsyncMatchesBaseline()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+
+		void* job = beginCompression(clip, nullptr);
+		int stage = -1;
+		while (pollCompression(job, &stage) == 0)
+			TEST_CHECK(stage >= 0 && stage < 4);
+		TEST_CHECK(stage == 4);
+		int asyncSize = 0;
+		void* async = endCompression(job, &asyncSize);
+		TEST_CHECK(asyncSize == size);
+		checkMatchesBaseline(baseline, async, clip.numSamples);
+
+		disposeCompressedTracksBuffer(async);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	// A cancelled job returns nothing, and everything it allocated through the callbacks is released before endCompression returns
+	void testCancelCompression()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		CountingAllocator allocator;
+		CompressionOptions options = CompressionOptions();
+		options.allocator = &allocator.callbacks;
+
+		// Cancelled while queued or compressing, depending on how quickly the pool picks each job up
+		const int numJobs = 4;
+		void* jobs[numJobs];
+		for (int i = 0; i < numJobs; i++)
+			jobs[i] = beginCompression(clip, &options);
+		for (int i = 0; i < numJobs; i++)
+			cancelCompression(jobs[i]);
+		for (int i = 0; i < numJobs; i++)
+		{
+			int size = -1;
+			TEST_CHECK(endCompression(jobs[i], &size) == nullptr);
+			TEST_CHECK(size == 0);
+		}
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+		TEST_CHECK(allocator.numLiveBytes.load() == 0);
+
+		// Cancelled after finishing, which disposes the finished result
+		void* job = beginCompression(clip, &options);
+		while (pollCompression(job, nullptr) == 0)
+			continue;
+		TEST_CHECK(allocator.numLiveAllocations.load() == 1);
+		cancelCompression(job);
+		int size = -1;
+		TEST_CHECK(endCompression(job, &size) == nullptr);
+		TEST_CHECK(size == 0);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+		TEST_CHECK(allocator.numLiveBytes.load() == 0);
+	}
+}
+
+int main()
+{
+	testBatchMatchesBaseline();
+	testAsyncMatchesBaseline();
+	testCancelCompression();
+	return finishTests();
+}
@@ -0,0 +1,263 @@
+#include "database.h"
+#include "test_utilities.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace AclUnityTests;
+
+namespace
+{
+	// A database holding a single clip, built with the counting allocator so that every buffer can be checked for leaks
+	struct TestDatabase
+	{
+		void* tracks;
+		void* database;
+		void* mediumTier;
+		void* lowTier;
+		int   databaseSize;
+		int   mediumTierSize;
+		int   lowTierSize;
+	};
+
+	TestDatabase buildDatabase(const TestClip& clip, CountingAllocator& allocator, void** outSourceTracks)
+	{
+		CompressionOptions options = CompressionOptions();
+		options.enableDatabaseSupport = 1;
+		int size = 0;
+		*outSourceTracks = compressSkeletonClipWithOptions(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr, &options);
+
+		TestDatabase result = {};
+		const void* sources[] = { *outSourceTracks };
+		result.database = buildSkeletonClipDatabase(sources, 1, 0.3f, 0.3f, &result.tracks, &result.databaseSize, &result.mediumTier, &result.mediumTierSize,
+													&result.lowTier, &result.lowTierSize, &allocator.callbacks);
+		return result;
+	}
+
+	void disposeDatabase(TestDatabase& database, CountingAllocator& allocator)
+	{
+		disposeCompressedTracksBufferWithAllocator(database.tracks, &allocator.callbacks);
+		disposeDatabaseBuffer(database.lowTier, database.lowTierSize, &allocator.callbacks);
+		disposeDatabaseBuffer(database.mediumTier, database.mediumTierSize, &allocator.callbacks);
+		disposeDatabaseBuffer(database.database, database.databaseSize, &allocator.callbacks);
+	}
+
+	// The largest difference at every keyframe between the clip sampled with a database and the clip it was built from
+	float databaseDifference(const void* context, const TestDatabase& database, const void* sourceTracks, int numSamples)
+	{
+		float difference = 0.f;
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+		for (int s = 0; s < numSamples; s++)
+		{
+			samplePoseWithDatabase(context, database.tracks, nullptr, pose.data(), timeOf(s), 3);
+			difference = std::max(difference, maxDifference(pose, samplePoseAt(sourceTracks, nullptr, timeOf(s), 3)));
+		}
+		return difference;
+	}
+
+	void testMemoryDatabase()
+	{
+		const TestClip clip = makeClip(60, true, 0.f);
+		CountingAllocator allocator;
+		void* sourceTracks = nullptr;
+		TestDatabase database = buildDatabase(clip, allocator, &sourceTracks);
+		TEST_CHECK(database.database != nullptr && database.tracks != nullptr);
+		TEST_CHECK(database.mediumTierSize > 0 && database.lowTierSize > 0);
+
+		void* context = createDatabaseContext(database.database, database.mediumTier, database.mediumTierSize, database.lowTier, database.lowTierSize);
+		TEST_CHECK(context != nullptr);
+		TEST_CHECK(isDatabaseTierStreamedIn(context, 1) == 0 && isDatabaseTierStreamedIn(context, 2) == 0);
+
+		// Without the tiers the missing keyframes are interpolated, so the clip only matches its source once both are resident
+		const float streamedOutDifference = databaseDifference(context, database, sourceTracks, clip.numSamples);
+		TEST_CHECK(streamInDatabaseTier(context, 1, 0) == 1);
+		TEST_CHECK(streamInDatabaseTier(context, 2, 0) == 1);
+		TEST_CHECK(isDatabaseTierStreamedIn(context, 1) == 1 && isDatabaseTierStreamedIn(context, 2) == 1);
+		const float streamedInDifference = databaseDifference(context, database, sourceTracks, clip.numSamples);
+		TEST_CHECK(streamedInDifference < 0.0001f);
+		TEST_CHECK(streamedInDifference <= streamedOutDifference);
+
+		TEST_CHECK(streamOutDatabaseTier(context, 2, 0) == 1);
+		TEST_CHECK(isDatabaseTierStreamedIn(context, 1) == 1 && isDatabaseTierStreamedIn(context, 2) == 0);
+		TEST_CHECK(streamInDatabaseTier(context, 3, 0) == 0);
+		TEST_CHECK(streamOutDatabaseTier(context, 0, 0) == 0);
+		destroyDatabaseContext(context);
+
+		// Buffers which are not databases are rejected
+		std::vector<Float4> notADatabase(16);
+		std::memset(notADatabase.data(), 0, notADatabase.size() * sizeof(Float4));
+		TEST_CHECK(createDatabaseContext(notADatabase[0].values, nullptr, 0, nullptr, 0) == nullptr);
+		TEST_CHECK(createDatabaseContext(database.database, database.mediumTier, -1, database.lowTier, database.lowTierSize) == nullptr);
+
+		disposeDatabase(database, allocator);
+		disposeCompressedTracksBuffer(sourceTracks);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+	}
+
+	bool appendToFile(std::FILE* file, const void* data, int sizeInBytes)
+	{
+		return std::fwrite(data, 1, static_cast<size_t>(sizeInBytes), file) == static_cast<size_t>(sizeInBytes);
+	}
+
+	// Reads complete on the streamer's worker thread, so tests poll until the condition holds or a few seconds pass
+	template<typename Condition>
+	bool waitFor(Condition condition)
+	{
+		for (int i = 0; i < 500; i++)
+		{
+			if (condition())
+				return true;
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return condition();
+	}
+
+	DatabaseStreamingStatistics getStatistics(void* fileStreamer)
+	{
+		DatabaseStreamingStatistics statistics;
+		getDatabaseFileStreamerStatistics(fileStreamer, &statistics);
+		return statistics;
+	}
+
+	// Two databases stream from one file within a budget which fits the first database, but not together with the medium tier
+	// of the second, so streaming that tier in evicts the low importance tier of the least recently requested context
+	void testFileStreamerEviction()
+	{
+		CountingAllocator allocator;
+		void* sourceTracks[2] = {};
+		TestDatabase databases[2] = { buildDatabase(makeClip(60, true, 0.f), allocator, &sourceTracks[0]), buildDatabase(makeClip(45, true, 0.1f), allocator, &sourceTracks[1]) };
+
+		const char* path = "aclunity_database_tiers.bin";
+		std::FILE* file = std::fopen(path, "wb");
+		TEST_CHECK(file != nullptr);
+		if (file == nullptr)
+			return;
+		long long offsets[2][2] = {};
+		long long fileSize = 0;
+		bool isWritten = true;
+		for (int d = 0; d < 2; d++)
+		{
+			offsets[d][0] = fileSize;
+			isWritten &= appendToFile(file, databases[d].mediumTier, databases[d].mediumTierSize);
+			offsets[d][1] = fileSize += databases[d].mediumTierSize;
+			isWritten &= appendToFile(file, databases[d].lowTier, databases[d].lowTierSize);
+			fileSize += databases[d].lowTierSize;
+		}
+		isWritten &= std::fclose(file) == 0;
+		TEST_CHECK(isWritten);
+
+		const long long budget = databases[0].mediumTierSize + std::max(databases[0].lowTierSize, databases[1].mediumTierSize);
+		void* streamer = createDatabaseFileStreamer(path, budget);
+		TEST_CHECK(streamer != nullptr);
+		void* contexts[2];
+		for (int d = 0; d < 2; d++)
+		{
+			contexts[d] = createFileDatabaseContext(streamer, databases[d].database, offsets[d][0], databases[d].mediumTierSize, offsets[d][1], databases[d].lowTierSize);
+			TEST_CHECK(contexts[d] != nullptr);
+		}
+		TEST_CHECK(createFileDatabaseContext(streamer, databases[0].database, -1, databases[0].mediumTierSize, offsets[0][1], databases[0].lowTierSize) == nullptr);
+		TEST_CHECK(createFileDatabaseContext(streamer, databases[0].database, offsets[0][0], -1, offsets[0][1], databases[0].lowTierSize) == nullptr);
+
+		TEST_CHECK(streamInDatabaseTier(contexts[0], 1, 0) == 1);
+		TEST_CHECK(streamInDatabaseTier(contexts[0], 2, 0) == 1);
+		TEST_CHECK(waitFor([&]() { return isDatabaseTierStreamedIn(contexts[0], 1) == 1 && isDatabaseTierStreamedIn(contexts[0], 2) == 1; }));
+		TEST_CHECK(databaseDifference(contexts[0], databases[0], sourceTracks[0], 60) < 0.0001f);
+		DatabaseStreamingStatistics statistics = getStatistics(streamer);
+		TEST_CHECK(statistics.residentSizeInBytes == databases[0].mediumTierSize + databases[0].lowTierSize);
+		TEST_CHECK(statistics.numFailedReads == 0 && statistics.bytesRead == statistics.residentSizeInBytes);
+
+		// A request for a resident tier is a hit and reads nothing
+		TEST_CHECK(streamInDatabaseTier(contexts[0], 1, 0) == 1);
+		TEST_CHECK(getStatistics(streamer).numHits == 1);
+
+		TEST_CHECK(streamInDatabaseTier(contexts[1], 1, 0) == 1);
+		TEST_CHECK(waitFor([&]() { return isDatabaseTierStreamedIn(contexts[1], 1) == 1; }));
+		statistics = getStatistics(streamer);
+		TEST_CHECK(statistics.numEvictions == 1);
+		TEST_CHECK(isDatabaseTierStreamedIn(contexts[0], 1) == 1 && isDatabaseTierStreamedIn(contexts[0], 2) == 0);
+		TEST_CHECK(statistics.residentSizeInBytes == databases[0].mediumTierSize + databases[1].mediumTierSize);
+		TEST_CHECK(statistics.residentSizeInBytes <= budget);
+
+		for (int d = 0; d < 2; d++)
+			destroyDatabaseContext(contexts[d]);
+		TEST_CHECK(getStatistics(streamer).residentSizeInBytes == 0);
+		destroyDatabaseFileStreamer(streamer);
+
+		void* tinyStreamer = createDatabaseFileStreamer(path, 1);
+		void* tinyContext = createFileDatabaseContext(tinyStreamer, databases[0].database, offsets[0][0], databases[0].mediumTierSize, offsets[0][1], databases[0].lowTierSize);
+		TEST_CHECK(streamInDatabaseTier(tinyContext, 1, 0) == 0);
+		TEST_CHECK(getStatistics(tinyStreamer).numRejectedRequests == 1);
+		destroyDatabaseContext(tinyContext);
+		destroyDatabaseFileStreamer(tinyStreamer);
+		std::remove(path);
+
+		for (int d = 0; d < 2; d++)
+		{
+			disposeDatabase(databases[d], allocator);
+			disposeCompressedTracksBuffer(sourceTracks[d]);
+		}
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+	}
+
+	// A tier whose reads all failed holds memory ACL never streams out. It is reclaimed when another tier needs its room in the
+	// budget, which must not count as an eviction, and when the tier is requested again.
+	void testFileStreamerFailedReads()
+	{
+		CountingAllocator allocator;
+		void* sourceTracks = nullptr;
+		TestDatabase database = buildDatabase(makeClip(60, true, 0.f), allocator, &sourceTracks);
+
+		const char* path = "aclunity_database_failed.bin";
+		std::FILE* file = std::fopen(path, "wb");
+		TEST_CHECK(file != nullptr);
+		if (file == nullptr)
+			return;
+		bool isWritten = appendToFile(file, database.mediumTier, database.mediumTierSize);
+		isWritten &= appendToFile(file, database.lowTier, database.lowTierSize);
+		isWritten &= std::fclose(file) == 0;
+		TEST_CHECK(isWritten);
+		const long long fileSize = database.mediumTierSize + database.lowTierSize;
+
+		void* streamer = createDatabaseFileStreamer(path, database.mediumTierSize);
+		// Its tiers lie past the end of the file, so every read fails
+		void* broken = createFileDatabaseContext(streamer, database.database, fileSize + 64, database.mediumTierSize, fileSize + 64, database.lowTierSize);
+		void* working = createFileDatabaseContext(streamer, database.database, 0, database.mediumTierSize, database.mediumTierSize, database.lowTierSize);
+		TEST_CHECK(broken != nullptr && working != nullptr);
+
+		TEST_CHECK(streamInDatabaseTier(broken, 1, 0) == 1);
+		TEST_CHECK(waitFor([&]() { return getStatistics(streamer).numFailedReads > 0 && getStatistics(streamer).numReads == getStatistics(streamer).numFailedReads; }));
+		TEST_CHECK(isDatabaseTierStreamedIn(broken, 1) == 0);
+		TEST_CHECK(getStatistics(streamer).residentSizeInBytes == database.mediumTierSize);
+
+		// Requesting the failed tier again frees it before reserving it anew, so the budget is not counted twice
+		const int numFailedReads = getStatistics(streamer).numFailedReads;
+		TEST_CHECK(streamInDatabaseTier(broken, 1, 0) == 1);
+		TEST_CHECK(waitFor([&]() { return getStatistics(streamer).numFailedReads > numFailedReads; }));
+		TEST_CHECK(getStatistics(streamer).residentSizeInBytes == database.mediumTierSize);
+
+		TEST_CHECK(streamInDatabaseTier(working, 1, 0) == 1);
+		TEST_CHECK(waitFor([&]() { return isDatabaseTierStreamedIn(working, 1) == 1; }));
+		const DatabaseStreamingStatistics statistics = getStatistics(streamer);
+		TEST_CHECK(statistics.numEvictions == 0);
+		TEST_CHECK(statistics.numRejectedRequests == 0);
+		TEST_CHECK(statistics.residentSizeInBytes == database.mediumTierSize);
+
+		destroyDatabaseContext(working);
+		destroyDatabaseContext(broken);
+		TEST_CHECK(getStatistics(streamer).residentSizeInBytes == 0);
+		destroyDatabaseFileStreamer(streamer);
+		std::remove(path);
+
+		disposeDatabase(database, allocator);
+		disposeCompressedTracksBuffer(sourceTracks);
+		TEST_CHECK(allocator.numLiveAllocations.load() == 0);
+	}
+}
+
+int main()
+{
+	testMemoryDatabase();
+	testFileStreamerEviction();
+	testFileStreamerFailedReads();
+	return finishTests();
+}
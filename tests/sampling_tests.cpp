@@ -0,0 +1,191 @@
+#include "test_utilities.h"
+
+using namespace AclUnityTests;
+
+namespace
+{
+	void testBaselineAccuracy()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int sizeInBytes = 0;
+		void* baseline = compressBaseline(clip, &sizeInBytes);
+		TEST_CHECK(baseline != nullptr && sizeInBytes > 0);
+
+		// Local space errors stay well within the object space shell error budget for this shallow skeleton
+		float difference = 0.f;
+		for (int s = 0; s < clip.numSamples; s++)
+			difference = std::max(difference, maxDifference(samplePoseAt(baseline, nullptr, timeOf(s), 3), rawPose(clip, s)));
+		TEST_CHECK(difference < 0.01f);
+
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	void testSampleRoundingModes()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+
+		for (int s = 0; s + 1 < clip.numSamples; s++)
+		{
+			const std::vector<float> first  = samplePoseAt(baseline, nullptr, timeOf(s), 3);
+			const std::vector<float> second = samplePoseAt(baseline, nullptr, timeOf(s + 1), 3);
+			const float nearFirst  = timeOf(s) + 0.25f / kSampleRate;
+			const float nearSecond = timeOf(s) + 0.75f / kSampleRate;
+
+			TEST_CHECK(maxDifference(samplePoseAt(baseline, nullptr, nearFirst, 3), first) == 0.f);
+			TEST_CHECK(maxDifference(samplePoseAt(baseline, nullptr, nearSecond, 3), second) == 0.f);
+
+			// The two directed modes each land on one of the neighboring keyframes, and never the same one
+			const std::vector<float> modeA = samplePoseAt(baseline, nullptr, nearFirst, 1);
+			const std::vector<float> modeB = samplePoseAt(baseline, nullptr, nearFirst, 2);
+			const bool isAFirst = maxDifference(modeA, first) == 0.f;
+			TEST_CHECK(isAFirst || maxDifference(modeA, second) == 0.f);
+			TEST_CHECK(maxDifference(modeB, isAFirst ? second : first) == 0.f);
+		}
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	// The constant child translations match the default pose and are stripped, while every rotation and the root translation stay animated
+	void testDefaultPoseSampling()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		const std::vector<float> defaultPose = rawPose(clip, 0);
+		CompressionOptions options = CompressionOptions();
+		options.defaultPose = defaultPose.data();
+		int size = 0;
+		void* compressed = compressSkeletonClipWithOptions(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, &size, nullptr, &options);
+		TEST_CHECK(compressed != nullptr && size > 0);
+
+		std::vector<float> pose(defaultPose.size(), 0.f);
+		float difference = 0.f;
+		for (int s = 0; s < clip.numSamples; s++)
+		{
+			samplePoseWithDefaults(compressed, nullptr, defaultPose.data(), pose.data(), timeOf(s), 3);
+			difference = std::max(difference, maxDifference(pose, rawPose(clip, s)));
+		}
+		TEST_CHECK(difference < 0.01f);
+
+		// Skipping the defaults leaves the prefilled default pose in place of every stripped sub-track
+		const float time = timeOf(17) + 0.3f / kSampleRate;
+		samplePoseWithDefaults(compressed, nullptr, defaultPose.data(), pose.data(), time, 0);
+		std::vector<float> skipped = defaultPose;
+		samplePoseSkipDefaults(compressed, nullptr, skipped.data(), time, 0);
+		TEST_CHECK(maxDifference(skipped, pose) == 0.f);
+
+		std::vector<float> blended(pose.size(), 0.f);
+		samplePoseWithDefaultsBlendedFirst(compressed, nullptr, defaultPose.data(), blended.data(), 0.5f, time, 0);
+		samplePoseWithDefaultsBlendedAdd(compressed, nullptr, defaultPose.data(), blended.data(), 0.5f, time, 0);
+		TEST_CHECK(maxDifference(blended, pose) < 0.00001f);
+
+		// samplePose cannot know the default pose and writes the stripped child translations as the identity
+		const std::vector<float> identityDefaults = samplePoseAt(compressed, nullptr, time, 0);
+		TEST_CHECK(identityDefaults[12 * 1 + 4] == 0.f && identityDefaults[12 * 1 + 5] == 0.f);
+		TEST_CHECK(identityDefaults[12 * 2 + 4] == 0.f && identityDefaults[12 * 2 + 5] == 0.f);
+
+		disposeCompressedTracksBuffer(compressed);
+	}
+
+	void testInitCacheMatchesSamplePose()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+
+		const size_t alignment = static_cast<size_t>(getClipInitCacheAlignment());
+		std::vector<unsigned char> memory(static_cast<size_t>(getClipInitCacheSize()) + 2 * alignment);
+		unsigned char* cache = memory.data() + (alignment - reinterpret_cast<size_t>(memory.data()) % alignment) % alignment;
+		TEST_CHECK(buildClipInitCache(baseline, nullptr, cache + 1) == 0 || alignment == 1);
+		TEST_CHECK(buildClipInitCache(baseline, nullptr, cache) == 1);
+
+		// Seeking back and forth through the same cache matches a freshly initialized context every time
+		float difference = 0.f;
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+		for (int s = 0; s < clip.numSamples; s++)
+		{
+			const float time = timeOf(s % 2 == 0 ? s : clip.numSamples - 1 - s) + 0.3f / kSampleRate;
+			TEST_CHECK(samplePoseWithInitCache(cache, baseline, nullptr, pose.data(), time, 0) == 1);
+			difference = std::max(difference, maxDifference(pose, samplePoseAt(baseline, nullptr, time, 0)));
+		}
+		TEST_CHECK(difference == 0.f);
+
+		// A cache built without scale tracks rejects a call with them and leaves the output untouched
+		std::fill(pose.begin(), pose.end(), -7.f);
+		TEST_CHECK(samplePoseWithInitCache(cache, baseline, baseline, pose.data(), 0.f, 0) == 0);
+		TEST_CHECK(pose[0] == -7.f);
+
+		float initializeNanoseconds = 0.f;
+		float initCacheNanoseconds  = 0.f;
+		benchmarkClipInitCache(baseline, nullptr, 64, &initializeNanoseconds, &initCacheNanoseconds);
+		TEST_CHECK(initializeNanoseconds > 0.f && initCacheNanoseconds > 0.f);
+		std::printf("samplePose: %.1f ns, samplePoseWithInitCache: %.1f ns\n", initializeNanoseconds, initCacheNanoseconds);
+
+		destroyClipInitCache(cache);
+		disposeCompressedTracksBuffer(baseline);
+	}
+
+	PoseSampleRequest makeRequest(const void* transformTracks, float* output, float time, unsigned char mode, unsigned char blendMode, float blendFactor)
+	{
+		PoseSampleRequest request;
+		request.compressedTransformTracks = transformTracks;
+		request.compressedScaleTracks     = nullptr;
+		request.aosOutputBuffer           = output;
+		request.time                      = time;
+		request.blendFactor               = blendFactor;
+		request.keyframeInterpolationMode = mode;
+		request.blendMode                 = blendMode;
+		return request;
+	}
+
+	void testBatchSamplerMatchesSamplePose()
+	{
+		const TestClip clip = makeClip(40, true, 0.f);
+		int size = 0;
+		void* baseline = compressBaseline(clip, &size);
+
+		const size_t poseSize = static_cast<size_t>(kNumBones) * 12;
+		const int numOutputs = 6;
+		std::vector<float> poses(numOutputs * poseSize, 0.f);
+		const float lerpTime    = timeOf(11) + 0.4f / kSampleRate;
+		const float roundedTime = timeOf(23) + 0.1f / kSampleRate;
+		const PoseSampleRequest requests[] =
+		{
+			// Exact duplicates decode once
+			makeRequest(baseline, poses.data(), lerpTime, 0, 0, 1.f),
+			makeRequest(baseline, poses.data() + poseSize, lerpTime, 0, 0, 1.f),
+			// Nearby times rounding to the same keyframe, and the same time in another mode, are sampled separately
+			makeRequest(baseline, poses.data() + 2 * poseSize, roundedTime, 3, 0, 1.f),
+			makeRequest(baseline, poses.data() + 3 * poseSize, roundedTime + 0.1f / kSampleRate, 3, 0, 1.f),
+			makeRequest(baseline, poses.data() + 4 * poseSize, lerpTime, 3, 0, 1.f),
+			// Requests blending into the same buffer apply in order
+			makeRequest(baseline, poses.data() + 5 * poseSize, lerpTime, 0, 1, 0.5f),
+			makeRequest(baseline, poses.data() + 5 * poseSize, lerpTime, 0, 2, 0.5f),
+		};
+		samplePoseBatch(requests, static_cast<int>(sizeof(requests) / sizeof(requests[0])));
+
+		const std::vector<float> lerped = samplePoseAt(baseline, nullptr, lerpTime, 0);
+		auto output = [&](int index) { return std::vector<float>(poses.begin() + index * poseSize, poses.begin() + (index + 1) * poseSize); };
+		TEST_CHECK(maxDifference(output(0), lerped) == 0.f);
+		TEST_CHECK(maxDifference(output(1), lerped) == 0.f);
+		TEST_CHECK(maxDifference(output(2), samplePoseAt(baseline, nullptr, roundedTime, 3)) == 0.f);
+		TEST_CHECK(maxDifference(output(3), samplePoseAt(baseline, nullptr, roundedTime + 0.1f / kSampleRate, 3)) == 0.f);
+		TEST_CHECK(maxDifference(output(4), samplePoseAt(baseline, nullptr, lerpTime, 3)) == 0.f);
+
+		std::vector<float> blended(poseSize, 0.f);
+		samplePoseBlendedFirst(baseline, nullptr, blended.data(), 0.5f, lerpTime, 0);
+		samplePoseBlendedAdd(baseline, nullptr, blended.data(), 0.5f, lerpTime, 0);
+		TEST_CHECK(maxDifference(output(5), blended) == 0.f);
+
+		disposeCompressedTracksBuffer(baseline);
+	}
+}
+
+int main()
+{
+	testBaselineAccuracy();
+	testSampleRoundingModes();
+	testDefaultPoseSampling();
+	testInitCacheMatchesSamplePose();
+	testBatchSamplerMatchesSamplePose();
+	return finishTests();
+}
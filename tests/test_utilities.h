@@ -0,0 +1,197 @@
+#pragma once
+
+#include "compression.h"
+#include "decompression.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Shared by every test executable. Each test file compresses the clips built here and compares its path against
+// compressSkeletonClip and samplePose, which the other paths must match. finishTests() returns 1 if any check failed,
+// so that ctest reports the failure.
+namespace AclUnityTests
+{
+	inline int& numFailures()
+	{
+		static int count = 0;
+		return count;
+	}
+
+	inline void checkCondition(bool condition, const char* expression, const char* file, int line)
+	{
+		if (condition)
+			return;
+		std::printf("%s(%d): check failed: %s\n", file, line, expression);
+		numFailures()++;
+	}
+
+#define TEST_CHECK(condition) AclUnityTests::checkCondition((condition), #condition, __FILE__, __LINE__)
+
+	inline int finishTests()
+	{
+		if (numFailures() != 0)
+			std::printf("%d checks failed\n", numFailures());
+		else
+			std::printf("All checks passed\n");
+		return numFailures() == 0 ? 0 : 1;
+	}
+
+	struct alignas(16) Float4
+	{
+		float values[4];
+	};
+
+	const signed short kParentIndices[]  = { 0, 0, 1, 2, 1 };
+	const signed short kNumBones         = 5;
+	const float        kSampleRate       = 30.f;
+	const float        kMaxDistanceError = 0.0001f;
+	const float        kShellDistance    = 0.03f;
+
+	// A bone-major AOS clip as documented by compressSkeletonClip
+	struct TestClip
+	{
+		std::vector<Float4> data;
+		int                 numSamples;
+
+		const float* get() const { return data[0].values; }
+		float*       get() { return data[0].values; }
+		const float* bone(int boneIndex, int sampleIndex) const { return data[3 * (static_cast<size_t>(boneIndex) * numSamples + sampleIndex)].values; }
+	};
+
+	// Each bone swings about its own axis, the root translates, and the uniform scale oscillates by scaleAmplitude.
+	// Angles stay below pi so that W stays positive, as ACL stores it.
+	inline TestClip makeClip(int numSamples, bool isAnimated, float scaleAmplitude)
+	{
+		TestClip clip;
+		clip.numSamples = numSamples;
+		clip.data.resize(static_cast<size_t>(kNumBones) * numSamples * 3);
+		for (int b = 0; b < kNumBones; b++)
+		{
+			for (int s = 0; s < numSamples; s++)
+			{
+				const float phase = isAnimated ? static_cast<float>(s) / kSampleRate : 0.f;
+				const float angle = 0.2f * static_cast<float>(b + 1) + phase;
+				float* bone = clip.data[3 * (static_cast<size_t>(b) * numSamples + s)].values;
+				const float axisLength = std::sqrt(1.f + static_cast<float>(b * b));
+				const float sinHalf = std::sin(0.5f * angle) / axisLength;
+				bone[0]  = sinHalf;
+				bone[1]  = sinHalf * static_cast<float>(b);
+				bone[2]  = 0.f;
+				bone[3]  = std::cos(0.5f * angle);
+				bone[4]  = b == 0 ? 0.5f * phase : 0.25f;
+				bone[5]  = b == 0 ? 0.f : 0.05f * static_cast<float>(b);
+				bone[6]  = 0.f;
+				bone[7]  = 0.f;
+				bone[8]  = 1.f;
+				bone[9]  = 1.f;
+				bone[10] = 1.f;
+				bone[11] = 1.f + scaleAmplitude * std::sin(3.f * phase + static_cast<float>(b));
+			}
+		}
+		return clip;
+	}
+
+	inline std::vector<float> samplePoseAt(const void* transformTracks, const void* scaleTracks, float time, unsigned char mode)
+	{
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12, 0.f);
+		samplePose(transformTracks, scaleTracks, pose.data(), time, mode);
+		return pose;
+	}
+
+	// Ignores the padding float of each translation, which samplers are free to leave undefined
+	inline float maxDifference(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		float difference = 0.f;
+		for (size_t i = 0; i < a.size() && i < b.size(); i++)
+		{
+			if (i % 12 != 7)
+				difference = std::max(difference, std::abs(a[i] - b[i]));
+		}
+		return a.size() == b.size() ? difference : 1e30f;
+	}
+
+	inline std::vector<float> rawPose(const TestClip& clip, int sampleIndex)
+	{
+		std::vector<float> pose(static_cast<size_t>(kNumBones) * 12);
+		for (int b = 0; b < kNumBones; b++)
+			std::memcpy(pose.data() + 12 * b, clip.bone(b, sampleIndex), 12 * sizeof(float));
+		return pose;
+	}
+
+	inline float timeOf(int sampleIndex)
+	{
+		return static_cast<float>(sampleIndex) / kSampleRate;
+	}
+
+	inline void* compressBaseline(const TestClip& clip, int* outSizeInBytes)
+	{
+		return compressSkeletonClip(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, outSizeInBytes, nullptr);
+	}
+
+	inline void* compressCombined(const TestClip& clip, int* outSizeInBytes)
+	{
+		return compressSkeletonClipWithScales(kParentIndices, kNumBones, 2, clip.get(), clip.numSamples, kSampleRate, kMaxDistanceError, kShellDistance, 0.0001f, 0.00001f, outSizeInBytes, nullptr);
+	}
+
+	// Every keyframe and every midpoint between keyframes must decompress identically
+	inline void checkMatchesBaseline(const void* baseline, const void* candidate, int numSamples)
+	{
+		float difference = 0.f;
+		for (int s = 0; s < numSamples; s++)
+		{
+			difference = std::max(difference, maxDifference(samplePoseAt(baseline, nullptr, timeOf(s), 0), samplePoseAt(candidate, nullptr, timeOf(s), 0)));
+			difference = std::max(difference, maxDifference(samplePoseAt(baseline, nullptr, timeOf(s) + 0.5f / kSampleRate, 0), samplePoseAt(candidate, nullptr, timeOf(s) + 0.5f / kSampleRate, 0)));
+		}
+		TEST_CHECK(difference == 0.f);
+	}
+
+	// Counts live allocations so that tests can verify every buffer routed through AllocatorCallbacks was released through them
+	struct CountingAllocator
+	{
+		std::atomic<int>       numLiveAllocations;
+		std::atomic<long long> numLiveBytes;
+		std::atomic<long long> numPeakBytes;
+		std::atomic<int>       numAllocations;
+		AllocatorCallbacks     callbacks;
+
+		CountingAllocator() : numLiveAllocations(0), numLiveBytes(0), numPeakBytes(0), numAllocations(0)
+		{
+			callbacks.allocate   = &CountingAllocator::allocate;
+			callbacks.deallocate = &CountingAllocator::deallocate;
+			callbacks.userData   = this;
+		}
+
+		// The original pointer is stored just before the aligned block
+		static void* allocate(void* userData, size_t size, size_t alignment)
+		{
+			CountingAllocator* allocator = static_cast<CountingAllocator*>(userData);
+			alignment = std::max(alignment, sizeof(void*));
+			unsigned char* memory = static_cast<unsigned char*>(std::malloc(size + alignment + sizeof(void*)));
+			const size_t address = reinterpret_cast<size_t>(memory + sizeof(void*));
+			unsigned char* aligned = memory + sizeof(void*) + (alignment - address % alignment) % alignment;
+			std::memcpy(aligned - sizeof(void*), &memory, sizeof(void*));
+			allocator->numLiveAllocations++;
+			allocator->numAllocations++;
+			const long long liveBytes = allocator->numLiveBytes += static_cast<long long>(size);
+			long long peakBytes = allocator->numPeakBytes.load();
+			while (liveBytes > peakBytes && !allocator->numPeakBytes.compare_exchange_weak(peakBytes, liveBytes))
+				continue;
+			return aligned;
+		}
+
+		static void deallocate(void* userData, void* ptr, size_t size)
+		{
+			CountingAllocator* allocator = static_cast<CountingAllocator*>(userData);
+			void* memory;
+			std::memcpy(&memory, static_cast<unsigned char*>(ptr) - sizeof(void*), sizeof(void*));
+			std::free(memory);
+			allocator->numLiveAllocations--;
+			allocator->numLiveBytes -= static_cast<long long>(size);
+		}
+	};
+}